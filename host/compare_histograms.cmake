@@ -0,0 +1,22 @@
+# Executado pelo ctest (cmake -P): histograma do galton_host em float contra o de galton_host_fixed
+# Variáveis: GALTON_HOST, GALTON_HOST_FIXED (executáveis) e OUTPUT (arquivo do histograma em float)
+#
+# 300000 ticks com 20 bolas por lançamento (~200 mil bolas): o bastante para o qui-quadrado enxergar
+# um desvio de arredondamento do Q16.16 (antes das correções de galton_fixed.h dava ~100 com limite ~21).
+
+set(GALTON_ARGS --headless --balls 20 --ticks 300000 --seed 3)
+
+execute_process(COMMAND ${GALTON_HOST} ${GALTON_ARGS}
+    OUTPUT_FILE ${OUTPUT}
+    RESULT_VARIABLE result)
+if(NOT result EQUAL 0)
+    message(FATAL_ERROR "galton_host terminou com ${result}")
+endif()
+
+execute_process(COMMAND ${GALTON_HOST_FIXED} ${GALTON_ARGS} --compare-histogram ${OUTPUT}
+    OUTPUT_VARIABLE output
+    RESULT_VARIABLE result)
+message(STATUS "${output}")
+if(NOT result EQUAL 0 OR NOT output MATCHES "same_distribution=1")
+    message(FATAL_ERROR "galton_host_fixed difere de galton_host (código ${result})")
+endif()
@@ -0,0 +1,33 @@
+# Executado pelo ctest (cmake -P): --dual headless trocando o tamanho da placa durante toda a execução
+# Variáveis: GALTON_HOST (executável)
+#
+# A cada 2000 ticks A e B ficam segurados por 40 ticks (mais que CHORD_HOLD_MS com o passo padrão),
+# então a geometria muda 200 vezes enquanto a thread de renderização consome fotografias. No modo
+# headless a simulação espera a tela a cada quadro, então a tela deve ver todas as trocas.
+# galton_host --dual termina com 1 se alguma chegar fora de ordem ou com a geometria voltando atrás.
+
+set(GALTON_ARGS --dual --headless --ticks 400000 --seed 3)
+set(reconfigurations 0)
+foreach(tick RANGE 1000 399000 2000)
+    list(APPEND GALTON_ARGS --press ${tick}:AB:40)
+    math(EXPR reconfigurations "${reconfigurations} + 1")
+endforeach()
+
+execute_process(COMMAND ${GALTON_HOST} ${GALTON_ARGS}
+    OUTPUT_VARIABLE output
+    RESULT_VARIABLE result)
+string(REGEX MATCH "frames_rendered=[^\n]*" stats "${output}")
+message(STATUS "${stats}")
+if(NOT result EQUAL 0)
+    message(FATAL_ERROR "galton_host --dual terminou com ${result}")
+endif()
+
+# Pelo menos um quadro e uma troca de geometria vista pela tela por reconfiguração
+string(REGEX REPLACE ".*frames_rendered=([0-9]+).*" "\\1" frames "${stats}")
+string(REGEX REPLACE ".*geometry_changes=([0-9]+).*" "\\1" changes "${stats}")
+if(NOT frames MATCHES "^[0-9]+$" OR frames LESS reconfigurations)
+    message(FATAL_ERROR "frames_rendered=${frames}, esperado pelo menos ${reconfigurations}")
+endif()
+if(NOT changes MATCHES "^[0-9]+$" OR changes LESS reconfigurations)
+    message(FATAL_ERROR "geometry_changes=${changes}, esperado pelo menos ${reconfigurations}")
+endif()
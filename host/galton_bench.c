@@ -0,0 +1,302 @@
+// Benchmarks nativos dos núcleos da simulação e da renderização
+//
+// Uso: galton_bench [--seed S] [--rows L] [--min-ms M] [--filter NOME] [--compare ARQUIVO.csv]
+//   --seed S       Semente das posições sorteadas (padrão: 1)
+//   --rows L       Linhas de pinos a medir, separadas por vírgula (padrão: PIN_ROWS,3,8)
+//   --min-ms M     Tempo mínimo medido por benchmark (padrão: 200 ms)
+//   --filter NOME  Só executa benchmarks cujo nome contém NOME
+//   --compare F    Lê um CSV anterior e acrescenta a razão novo/antigo (>1 = mais lento)
+//
+// Saída em CSV (uma linha por medida), para guardar e comparar entre commits:
+//   benchmark,rows,param,iterations,ns_per_op[,baseline_ns,ratio]
+// Cada quantidade de linhas troca a placa com reconfigure_board() (N linhas, N+1 caixas) e
+// repete os benchmarks que dependem da placa; os primitivos de desenho rodam uma vez.
+
+#define _POSIX_C_SOURCE 200809L
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include "inc/galton_config.h"
+#include "inc/galton_stats.h"
+#include "inc/galton_board.h"
+#include "inc/galton_geometry.h" // Geometria do boot (espaçamentos padrão)
+#include "pico_shim.h"
+
+#define BENCH_MAX_BASELINE 64  // Linhas lidas de --compare
+#define BENCH_POINTS 4096      // Coordenadas sorteadas para os primitivos de desenho
+#define BENCH_MAX_ROWS 8       // Quantidades de linhas em --rows
+
+static galton_rng_t bench_rng;        // Fluxo próprio: não mexe no sim_rng da simulação
+static double bench_min_ns = 200e6;   // Tempo mínimo medido por benchmark
+static const char *bench_filter = NULL;
+
+/* Resultados de uma execução anterior (--compare) */
+static struct {
+    char name[48];
+    int rows;
+    long param;
+    double ns_per_op;
+} baseline[BENCH_MAX_BASELINE];
+static int baseline_count = 0;
+
+static uint8_t point_x[BENCH_POINTS], point_y[BENCH_POINTS]; // Pontos sorteados para desenho
+
+static double now_ns(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec * 1e9 + ts.tv_nsec;
+}
+
+static void usage(const char *prog) {
+    fprintf(stderr, "Uso: %s [--seed S] [--rows L] [--min-ms M] [--filter NOME] [--compare ARQUIVO.csv]\n", prog);
+}
+
+static bool bench_enabled(const char *name) {
+    return bench_filter == NULL || strstr(name, bench_filter) != NULL;
+}
+
+/************ Saída e comparação ************/
+static void load_baseline(const char *path) {
+    FILE *f = fopen(path, "r");
+    if (!f) {
+        perror(path);
+        exit(1);
+    }
+
+    char line[256];
+    while (fgets(line, sizeof(line), f) && baseline_count < BENCH_MAX_BASELINE) {
+        long iterations;
+        if (sscanf(line, "%47[^,],%d,%ld,%ld,%lf", baseline[baseline_count].name, &baseline[baseline_count].rows,
+                   &baseline[baseline_count].param, &iterations, &baseline[baseline_count].ns_per_op) == 5) {
+            baseline_count++;
+        }
+    }
+    fclose(f);
+}
+
+static void report(const char *name, long param, long iterations, double ns_per_op) {
+    int rows = main_board.params.pin_rows; // A placa medida, não a do boot
+    printf("%s,%d,%ld,%ld,%.2f", name, rows, param, iterations, ns_per_op);
+
+    for (int i = 0; i < baseline_count; i++) {
+        if (strcmp(baseline[i].name, name) == 0 && baseline[i].rows == rows && baseline[i].param == param) {
+            printf(",%.2f,%.3f", baseline[i].ns_per_op, ns_per_op / baseline[i].ns_per_op);
+            break;
+        }
+    }
+    putchar('\n');
+    fflush(stdout);
+}
+
+/************ Preparação do estado ************/
+// Espalha 'count' bolas pelo campo de pinos, com velocidades típicas de queda
+static void scatter_particles(int count) {
+    galton_board_t *b = &main_board;
+    int top = PIN_TOP_Y - b->params.pin_spacing_v;
+    int bottom = b->params.histogram_base_y - BALL_DIAMETER - 8; // Longe da base: quase nenhuma pousa durante a medida
+
+    ParticlePool *particles = &b->particles;
+
+    particles->count = 0;
+    for (int i = 0; i < count; i++) {
+        int index = board_spawn_particle(b);
+        particles->x[index] = PHYS_FROM_INT(b->wall_left + 1 + (int)rng_below(&bench_rng, b->wall_right - b->wall_left - 1));
+        particles->y[index] = PHYS_FROM_INT(top + (int)rng_below(&bench_rng, bottom - top));
+        particles->vx[index] = PHYS_FROM_FLOAT(((int)rng_below(&bench_rng, 200) - 100) / 100.0f);
+        particles->vy[index] = PHYS_FROM_FLOAT(rng_below(&bench_rng, 150) / 100.0f);
+    }
+}
+
+/************ Benchmarks ************/
+// update_particles() com 'count' bolas vivas; o estado é refeito a cada lote de ticks
+static void bench_update_particles(int count) {
+    const int ticks_per_batch = 4;
+    double timed = 0;
+    long ticks = 0;
+
+    BALLS_PER_DROP = 0; // Sem lançamentos: o número de bolas fica fixo
+    while (timed < bench_min_ns) {
+        scatter_particles(count);
+
+        double start = now_ns();
+        for (int t = 0; t < ticks_per_batch; t++) update_particles();
+        timed += now_ns() - start;
+        ticks += ticks_per_batch;
+    }
+    BALLS_PER_DROP = 1;
+
+    report("update_particles", count, ticks, timed / ticks);
+}
+
+// Colisão com os pinos (board_check_pin_collisions) isolada, sobre bolas espalhadas pelo campo de pinos
+static void bench_check_pin_collisions(void) {
+    const int count = 4096;
+    double timed = 0;
+    long calls = 0;
+
+    while (timed < bench_min_ns) {
+        scatter_particles(count);
+
+        double start = now_ns();
+        for (int i = 0; i < count; i++) board_check_pin_collisions(&main_board, i);
+        timed += now_ns() - start;
+        calls += count;
+    }
+
+    report("check_pin_collisions", count, calls, timed / calls);
+}
+
+// Quadro completo de render_oled(): camada estática, bolas, histograma, texto e envio (shim do I2C/DMA)
+static void bench_render_oled(int count) {
+    double timed = 0;
+    long frames = 0;
+
+    for (int i = 0; i < main_board.hist.num_bins; i++) histogram_add(&main_board.hist, i, 100 + 37 * i);
+    while (timed < bench_min_ns) {
+        scatter_particles(count); // Bolas em lugares novos: o envio parcial também tem trabalho
+
+        double start = now_ns();
+        render_oled();
+        timed += now_ns() - start;
+        frames++;
+    }
+
+    report("render_oled", count, frames, timed / frames);
+}
+
+static void bench_set_pixel(void) {
+    double timed = 0;
+    long calls = 0;
+
+    while (timed < bench_min_ns) {
+        double start = now_ns();
+        for (int i = 0; i < BENCH_POINTS; i++) ssd1306_set_pixel(oled_buffer, point_x[i], point_y[i], i & 1);
+        timed += now_ns() - start;
+        calls += BENCH_POINTS;
+    }
+
+    report("ssd1306_set_pixel", 0, calls, timed / calls);
+}
+
+static void bench_draw_line(void) {
+    double timed = 0;
+    long calls = 0;
+
+    while (timed < bench_min_ns) {
+        double start = now_ns();
+        for (int i = 0; i + 1 < BENCH_POINTS; i += 2) {
+            ssd1306_draw_line(oled_buffer, point_x[i], point_y[i], point_x[i + 1], point_y[i + 1], true);
+        }
+        timed += now_ns() - start;
+        calls += BENCH_POINTS / 2;
+    }
+
+    report("ssd1306_draw_line", 0, calls, timed / calls);
+}
+
+static void bench_draw_string(void) {
+    char text[] = "T:123456";
+    double timed = 0;
+    long calls = 0;
+
+    while (timed < bench_min_ns) {
+        double start = now_ns();
+        for (int i = 0; i < BENCH_POINTS; i++) {
+            ssd1306_draw_string(oled_buffer, point_x[i] & 63, point_y[i] & ~7, text);
+        }
+        timed += now_ns() - start;
+        calls += BENCH_POINTS;
+    }
+
+    report("ssd1306_draw_string", (long)strlen(text), calls, timed / calls);
+}
+
+// Troca a placa da tela para 'rows' linhas e rows+1 caixas, com o espaçamento vertical
+// reduzido se as linhas não couberem acima do histograma
+static bool bench_set_rows(int rows) {
+    int room = HISTOGRAM_BASE_Y - MAX_HISTOGRAM_HEIGHT - PIN_TOP_Y;
+    int spacing_v = BOARD_PIN_SPACING_V;
+    if (rows * spacing_v > room) spacing_v = room / rows;
+
+    if (!reconfigure_board(rows, rows + 1, BOARD_PIN_SPACING_H, spacing_v, BOARD_BIN_WIDTH)) {
+        fprintf(stderr, "galton_bench: %d linhas não cabem na tela\n", rows);
+        return false;
+    }
+    return true;
+}
+
+// Lê "5,3,8" em 'rows'; retorna quantas (0 se inválido)
+static int parse_rows(const char *arg, int *rows) {
+    int n = 0;
+    char *end;
+
+    do {
+        long r = strtol(arg, &end, 10);
+        if (end == arg || r < 1 || r > MAX_PIN_ROWS || n >= BENCH_MAX_ROWS) return 0;
+        rows[n++] = (int)r;
+        arg = end + 1;
+    } while (*end == ',');
+    return *end ? 0 : n;
+}
+
+int main(int argc, char **argv) {
+    uint64_t seed = 1;
+    int rows[BENCH_MAX_ROWS] = { PIN_ROWS, 3, 8 };
+    int row_count = 3;
+
+    for (int i = 1; i < argc; i++) {
+        if (strcmp(argv[i], "--seed") == 0 && i + 1 < argc) {
+            seed = strtoull(argv[++i], NULL, 0);
+        } else if (strcmp(argv[i], "--rows") == 0 && i + 1 < argc && (row_count = parse_rows(argv[i + 1], rows)) > 0) {
+            i++;
+        } else if (strcmp(argv[i], "--min-ms") == 0 && i + 1 < argc) {
+            bench_min_ns = strtod(argv[++i], NULL) * 1e6;
+        } else if (strcmp(argv[i], "--filter") == 0 && i + 1 < argc) {
+            bench_filter = argv[++i];
+        } else if (strcmp(argv[i], "--compare") == 0 && i + 1 < argc) {
+            load_baseline(argv[++i]);
+        } else {
+            usage(argv[0]);
+            return 1;
+        }
+    }
+
+    pico_shim_set_virtual_time(true); // Lançamentos e debounce não dependem da velocidade da máquina
+    RNG_SEED = seed;
+    setup();
+    ssd1306_dma_init();
+    rng_seed(&bench_rng, seed, 1);
+
+    for (int i = 0; i < BENCH_POINTS; i++) {
+        point_x[i] = (uint8_t)rng_below(&bench_rng, OLED_WIDTH);
+        point_y[i] = (uint8_t)rng_below(&bench_rng, OLED_HEIGHT);
+    }
+
+    printf("benchmark,rows,param,iterations,ns_per_op%s\n", baseline_count ? ",baseline_ns,ratio" : "");
+
+    static const int update_counts[] = { 16, 256, 4096, MAX_PARTICLES };
+    for (int r = 0; r < row_count; r++) {
+        if (!bench_set_rows(rows[r])) return 1;
+
+        if (bench_enabled("update_particles")) {
+            for (size_t i = 0; i < count_of(update_counts); i++) {
+                if (update_counts[i] <= MAX_PARTICLES) bench_update_particles(update_counts[i]);
+            }
+        }
+        if (bench_enabled("check_pin_collisions")) bench_check_pin_collisions();
+        if (bench_enabled("render_oled")) {
+            bench_render_oled(16);
+            bench_render_oled(256);
+        }
+    }
+
+    // Primitivos de desenho: não dependem da placa (a linha sai com a primeira quantidade de linhas)
+    if (!bench_set_rows(rows[0])) return 1;
+    if (bench_enabled("ssd1306_set_pixel")) bench_set_pixel();
+    if (bench_enabled("ssd1306_draw_line")) bench_draw_line();
+    if (bench_enabled("ssd1306_draw_string")) bench_draw_string();
+
+    return 0;
+}
@@ -0,0 +1,170 @@
+// Decodificador da telemetria binária (galton_telemetry.h)
+//
+// Uso: galton_decode [--input ARQ] [--format csv|columns] [--out DIR]
+//   --input ARQ   Porta serial do firmware (/dev/ttyACM0), pty, FIFO ou arquivo (padrão: entrada padrão)
+//   --format csv  Uma linha por evento: tick,bin,count,bias,balls_per_drop (padrão, na saída padrão)
+//   --format columns
+//                 Um arquivo binário por coluna em DIR (tick.u32, bin.u8, count.u32, bias_x10.u8,
+//                 balls_per_drop.u8, little-endian) e DIR/schema.txt com tipos e número de linhas
+//   --out DIR     Diretório das colunas (padrão: telemetry)
+//
+// Lê até o fim da entrada (ou Ctrl+C na porta serial). Bytes fora de quadros, como o texto
+// do resumo de tempos, são ignorados; ao final o resumo de quadros e perdas vai para stderr.
+
+#define _DEFAULT_SOURCE
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <signal.h>
+#include <unistd.h>
+#include <termios.h>
+#include <sys/stat.h>
+#include "inc/galton_telemetry.h"
+
+#define COLUMN_COUNT 5
+
+static volatile sig_atomic_t stop_requested;
+
+static void on_signal(int sig) {
+    (void)sig;
+    stop_requested = 1;
+}
+
+/************ Saída em colunas ************/
+static const char *column_names[COLUMN_COUNT] = {"tick", "bin", "count", "bias_x10", "balls_per_drop"};
+static const char *column_types[COLUMN_COUNT] = {"u32", "u8", "u32", "u8", "u8"};
+static FILE *columns[COLUMN_COUNT];
+static uint64_t rows;
+
+static void put_u32(FILE *f, uint32_t v) {
+    uint8_t b[4] = {(uint8_t)v, (uint8_t)(v >> 8), (uint8_t)(v >> 16), (uint8_t)(v >> 24)};
+    fwrite(b, 1, sizeof(b), f);
+}
+
+static void write_columns(const telemetry_event_t *ev, void *ctx) {
+    (void)ctx;
+    put_u32(columns[0], ev->tick);
+    fputc(ev->bin, columns[1]);
+    put_u32(columns[2], ev->count);
+    fputc(ev->bias_x10, columns[3]);
+    fputc(ev->balls_per_drop, columns[4]);
+    rows++;
+}
+
+static bool open_columns(const char *dir) {
+    char path[4096];
+
+    if (mkdir(dir, 0777) != 0 && errno != EEXIST) {
+        perror(dir);
+        return false;
+    }
+    for (int c = 0; c < COLUMN_COUNT; c++) {
+        snprintf(path, sizeof(path), "%s/%s.%s", dir, column_names[c], column_types[c]);
+        columns[c] = fopen(path, "wb");
+        if (!columns[c]) {
+            perror(path);
+            return false;
+        }
+    }
+    return true;
+}
+
+static void close_columns(const char *dir) {
+    char path[4096];
+
+    for (int c = 0; c < COLUMN_COUNT; c++) fclose(columns[c]);
+
+    snprintf(path, sizeof(path), "%s/schema.txt", dir);
+    FILE *schema = fopen(path, "w");
+    if (!schema) {
+        perror(path);
+        return;
+    }
+    fprintf(schema, "rows=%llu\n", (unsigned long long)rows);
+    for (int c = 0; c < COLUMN_COUNT; c++) {
+        fprintf(schema, "%s %s %s.%s\n", column_names[c], column_types[c], column_names[c], column_types[c]);
+    }
+    fclose(schema);
+}
+
+/************ Saída em CSV ************/
+static void write_csv(const telemetry_event_t *ev, void *ctx) {
+    (void)ctx;
+    printf("%lu,%u,%lu,%.1f,%u\n", (unsigned long)ev->tick, ev->bin, (unsigned long)ev->count,
+           ev->bias_x10 / 10.0, ev->balls_per_drop);
+    rows++;
+}
+
+static void usage(const char *prog) {
+    fprintf(stderr, "Uso: %s [--input ARQ] [--format csv|columns] [--out DIR]\n", prog);
+}
+
+int main(int argc, char **argv) {
+    const char *input = NULL;
+    const char *out_dir = "telemetry";
+    bool csv = true;
+
+    for (int i = 1; i < argc; i++) {
+        if (strcmp(argv[i], "--input") == 0 && i + 1 < argc) {
+            input = argv[++i];
+        } else if (strcmp(argv[i], "--format") == 0 && i + 1 < argc) {
+            const char *format = argv[++i];
+            if (strcmp(format, "csv") == 0) {
+                csv = true;
+            } else if (strcmp(format, "columns") == 0) {
+                csv = false;
+            } else {
+                usage(argv[0]);
+                return 1;
+            }
+        } else if (strcmp(argv[i], "--out") == 0 && i + 1 < argc) {
+            out_dir = argv[++i];
+        } else {
+            usage(argv[0]);
+            return 1;
+        }
+    }
+
+    int fd = input ? open(input, O_RDONLY | O_NOCTTY) : STDIN_FILENO;
+    if (fd < 0) {
+        perror(input);
+        return 1;
+    }
+
+    // Porta serial ou pty: modo bruto, sem eco nem conversão de fim de linha
+    if (isatty(fd)) {
+        struct termios tio;
+        if (tcgetattr(fd, &tio) == 0) {
+            cfmakeraw(&tio);
+            tcsetattr(fd, TCSANOW, &tio);
+        }
+    }
+
+    if (!csv && !open_columns(out_dir)) return 1;
+    if (csv) printf("tick,bin,count,bias,balls_per_drop\n");
+
+    signal(SIGINT, on_signal);
+    signal(SIGTERM, on_signal);
+
+    static telemetry_parser_t parser;
+    telemetry_parser_init(&parser);
+
+    uint8_t buf[4096];
+    while (!stop_requested) {
+        ssize_t n = read(fd, buf, sizeof(buf));
+        if (n < 0 && errno == EINTR) continue;
+        if (n <= 0) break;
+        telemetry_parse(&parser, buf, (size_t)n, csv ? write_csv : write_columns, NULL);
+    }
+
+    if (!csv) close_columns(out_dir);
+    fflush(stdout);
+    fprintf(stderr, "frames=%llu events=%llu rows=%llu bad_frames=%llu skipped_bytes=%llu events_lost=%llu sequence_gaps=%llu\n",
+            (unsigned long long)parser.frames, (unsigned long long)parser.events, (unsigned long long)rows,
+            (unsigned long long)parser.bad_frames, (unsigned long long)parser.skipped_bytes,
+            (unsigned long long)parser.events_lost, (unsigned long long)parser.sequence_gaps);
+    return 0;
+}
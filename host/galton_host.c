@@ -0,0 +1,591 @@
+// Ponto de entrada nativo (Linux) da Galton Board
+//
+// Uso: galton_host [--headless] [--virtual] [--dual] [--fast] [--sampler NOME] [--seed S] [--balls N]
+//                   [--ticks N] [--fps F] [--compare-samplers N] [--compare-histogram ARQ] [--telemetry ARQ]
+//                   [--press TICK:A|B|AB[:N]]... [--command TICK:LINHA]... [--record ARQ] [--replay ARQ]
+//   --headless  Executa update_particles() o mais rápido possível, sem renderizar
+//               e sem a espera de TICK_DELAY_MS (o relógio virtual avança a cada tick)
+//   --virtual   Relógio virtual também com a tela (quadros reprodutíveis, sem esperar)
+//   --dual      Simulação e renderização em threads separadas (como os dois núcleos; com --headless
+//               a simulação espera a renderização consumir cada fotografia); código de
+//               saída 1 se a fila entregar fotografias fora de ordem ou com a geometria voltando atrás
+//   --fast      Modo binomial rápido (SIM_MODE_FAST_BINOMIAL)
+//   --sampler   Sorteador do modo rápido: scalar (padrão), simd (AVX2 se houver) ou lanes (portátil)
+//   --seed S    Semente do gerador (padrão: relógio, que no modo headless começa em 0)
+//   --balls N   Bolas por lançamento (BALLS_PER_DROP; o botão A só vai até 5)
+//   --ticks N   Número de ticks a simular (padrão: 10000 headless, infinito na tela)
+//   --fps F     Taxa de quadros desejada (TARGET_FPS); a física segue em passos de TICK_DELAY_MS
+//   --compare-samplers N
+//               Sorteia N bolas com cada sorteador, para os vieses 0, 1, 3, 5, 7 e 10, e confere: simd e
+//               lanes idênticos bit a bit, scalar e simd com a mesma distribuição (qui-quadrado de duas
+//               amostras a 99,9%).
+//               Código de saída 1 se alguma conferência falhar.
+//   --compare-histogram ARQ
+//               Ao fim do modo headless compara o histograma com as linhas "bin[k]=N" de ARQ (a saída
+//               de outra execução, ex.: galton_host contra galton_host_fixed) pelo qui-quadrado de duas
+//               amostras a 99,9%. Código de saída 1 se as distribuições diferirem.
+//   --telemetry ARQ
+//               Grava os pousos da placa da tela no formato binário da USB (galton_telemetry.h)
+//               em ARQ (arquivo, FIFO ou pty; "-" é a saída padrão)
+//   --press T:B[:N]
+//               Pressiona o botão A, B ou os dois antes do tick T, segurando por N ticks (padrão 1;
+//               pelo GPIO emulado, cujas bordas chamam a IRQ de galton_input.c; repetível). O toque
+//               vale ao soltar; segurado por LONG_PRESS_MS é um toque longo, e A e B segurados por
+//               CHORD_HOLD_MS trocam o tamanho da placa
+//   --command T:LINHA
+//               Executa antes do tick T um comando do terminal USB (galton_command.h), por
+//               exemplo "300:board 7 8" (repetível)
+//   --record ARQ
+//               Grava semente, parâmetros iniciais, botões e hash do estado em ARQ (galton_replay.h)
+//   --replay ARQ
+//               Reproduz a gravação de --record (ou o log USB com "replay=<hex>" do firmware) pelo
+//               número de ticks gravado e confere o hash; código de saída 1 se divergir
+//
+// Compilado com GALTON_PROFILE (galton_host_profile), imprime ao final em stderr o
+// resumo mín/média/p99 de cada fase medida.
+
+#include <stdio.h>
+#include <math.h>
+#include <stdlib.h>
+#include <string.h>
+#include <ctype.h>
+#include <time.h>
+#include <pthread.h>
+#include <sched.h>
+#include <stdatomic.h>
+#include "inc/galton_config.h"
+#include "inc/galton_pipeline.h"
+#include "inc/galton_scheduler.h"
+#include "inc/galton_profile.h"
+#include "inc/galton_stats.h"
+#include "inc/galton_board.h"
+#include "inc/galton_binomial.h"
+#include "inc/galton_telemetry.h"
+#include "inc/galton_replay.h"
+#include "inc/galton_command.h"
+#include "pico_shim.h"
+
+// Tempo de parede em segundos, para medir a vazão do modo headless
+static double wall_seconds(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec + ts.tv_nsec / 1e9;
+}
+
+static void usage(const char *prog) {
+    fprintf(stderr, "Uso: %s [--headless] [--virtual] [--dual] [--fast] [--sampler scalar|simd|lanes] [--seed S]\n"
+                    "       [--balls N] [--ticks N] [--fps F] [--compare-samplers N] [--compare-histogram ARQ]\n"
+                    "       [--telemetry ARQ] [--press TICK:A|B|AB[:N]]... [--command TICK:LINHA]... [--record ARQ] [--replay ARQ]\n", prog);
+}
+
+// Imprime o histograma atual, o total de bolas lançadas e as estatísticas
+static void print_histogram(void) {
+    const galton_stats_t *stats = &main_board.hist.stats;
+
+    printf("total_particles=%llu\n", (unsigned long long)main_board.total_particles);
+    for (int i = 0; i < main_board.hist.num_bins; i++) {
+        printf("bin[%d]=%llu\n", i, (unsigned long long)main_board.hist.bins[i]);
+    }
+    printf("mean=%.6f variance=%.6f skewness=%.6f chi_square=%.6f\n",
+           stats_mean(stats), stats_variance(stats), stats_skewness(stats), stats_chi_square(stats));
+}
+
+/************ Telemetria ************/
+static FILE *telemetry_out; // Destino dos quadros (NULL: telemetria desligada)
+
+static void telemetry_write_file(const uint8_t *data, size_t len, void *ctx) {
+    fwrite(data, 1, len, (FILE *)ctx);
+}
+
+// Como telemetry_poll() do firmware, mas por lote: envia ao juntar um quadro (ou tudo, no fim)
+static void host_telemetry_poll(bool force) {
+    if (!telemetry_out) return;
+    if (force || telemetry_pending(&telemetry_ring) >= TELEMETRY_FRAME_EVENTS) {
+        telemetry_flush(&telemetry_ring, telemetry_write_file, telemetry_out);
+    }
+    if (force) fflush(telemetry_out);
+}
+
+/************ Botões e comandos programados, gravação e reprodução ************/
+#define MAX_PRESSES 256
+#define MAX_COMMANDS 16
+
+static struct {
+    uint32_t tick;
+    uint32_t hold; // Ticks segurando
+    int buttons;   // REPLAY_BUTTON_A | REPLAY_BUTTON_B
+} presses[MAX_PRESSES];
+static int press_count;
+
+static struct {
+    uint32_t tick;
+    const char *line;
+} commands[MAX_COMMANDS];
+static int command_count;
+
+// Ticks executados por este programa: a placa volta ao tick 0 quando muda de tamanho
+static uint32_t host_ticks;
+
+static bool parse_press(const char *arg) {
+    char *end;
+    unsigned long tick = strtoul(arg, &end, 10);
+    unsigned long hold = 1;
+    int buttons = 0;
+
+    if (*end++ != ':' || press_count >= MAX_PRESSES) return false;
+    for (; *end && *end != ':'; end++) {
+        if (*end == 'A' || *end == 'a') buttons |= REPLAY_BUTTON_A;
+        else if (*end == 'B' || *end == 'b') buttons |= REPLAY_BUTTON_B;
+        else return false;
+    }
+    if (*end == ':' && ((hold = strtoul(end + 1, &end, 10)) == 0 || *end)) return false;
+    presses[press_count].tick = (uint32_t)tick;
+    presses[press_count].hold = (uint32_t)hold;
+    presses[press_count].buttons = buttons;
+    press_count++;
+    return buttons != 0;
+}
+
+static bool parse_command(const char *arg) {
+    char *end;
+    unsigned long tick = strtoul(arg, &end, 10);
+
+    if (*end != ':' || command_count >= MAX_COMMANDS) return false;
+    commands[command_count].tick = (uint32_t)tick;
+    commands[command_count].line = end + 1;
+    command_count++;
+    return true;
+}
+
+// Aperta no GPIO emulado os botões programados que estão segurados no tick e solta os demais
+static void set_scripted_buttons(uint32_t tick) {
+    int buttons = 0;
+
+    for (int i = 0; i < press_count; i++) {
+        if (tick - presses[i].tick < presses[i].hold) buttons |= presses[i].buttons;
+    }
+    pico_shim_set_gpio(BUTTON_A_PIN, !(buttons & REPLAY_BUTTON_A));
+    pico_shim_set_gpio(BUTTON_B_PIN, !(buttons & REPLAY_BUTTON_B));
+}
+
+// Comandos programados para o tick, como se chegassem pelo terminal USB
+static void run_scripted_commands(uint32_t tick) {
+    for (int i = 0; i < command_count; i++) {
+        if (commands[i].tick == tick) command_execute(commands[i].line);
+    }
+}
+
+// Lê a gravação: arquivo binário de --record ou a última linha "replay=<hex>" de um log USB
+static bool load_replay(const char *path) {
+    static uint8_t file[1 << 20];
+    static uint8_t bytes[REPLAY_MAX_BYTES];
+    FILE *f = fopen(path, "rb");
+
+    if (!f) {
+        perror(path);
+        return false;
+    }
+    size_t len = fread(file, 1, sizeof(file) - 1, f);
+    fclose(f);
+    file[len] = 0;
+
+    const char *hex = NULL;
+    for (const char *p = (const char *)file; (p = strstr(p, "replay=")) != NULL; p++) hex = p + 7;
+    if (!hex) return replay_load(&replay, file, len);
+
+    size_t n = 0;
+    unsigned byte;
+    while (n < sizeof(bytes) && isxdigit((unsigned char)hex[2 * n]) && isxdigit((unsigned char)hex[2 * n + 1]) &&
+           sscanf(hex + 2 * n, "%2x", &byte) == 1) {
+        bytes[n++] = (uint8_t)byte;
+    }
+    return replay_load(&replay, bytes, n);
+}
+
+static bool save_recording(const char *path) {
+    static uint8_t bytes[REPLAY_MAX_BYTES];
+    size_t len = replay_serialize(&replay, bytes, sizeof(bytes));
+    FILE *f = fopen(path, "wb");
+
+    if (!f || fwrite(bytes, 1, len, f) != len) {
+        perror(path);
+        if (f) fclose(f);
+        return false;
+    }
+    fclose(f);
+    return true;
+}
+
+// Fim da execução: salva a gravação ou confere a reprodução (retorna o código de saída)
+static int finish_replay(const char *record_path) {
+    if (replay.mode == REPLAY_RECORDING) {
+        replay_record_checkpoint(&replay, main_board.steps);
+        if (!save_recording(record_path)) return 1;
+        printf("recorded_ticks=%lu state_hash=%016llx\n", (unsigned long)replay.header.ticks,
+               (unsigned long long)replay.header.state_hash);
+    } else if (replay.mode == REPLAY_PLAYING) {
+        bool ok = replay.hash == replay.header.state_hash;
+        printf("replay_ticks=%lu replay_hash=%016llx recorded_hash=%016llx replay_ok=%d\n",
+               (unsigned long)main_board.steps, (unsigned long long)replay.hash,
+               (unsigned long long)replay.header.state_hash, ok);
+        if (!ok) return 1;
+    }
+    return 0;
+}
+
+// Passo do escalonador com os botões e comandos programados e o envio da telemetria
+static void update_and_poll(void) {
+    uint32_t tick = host_ticks++;
+
+    run_scripted_commands(tick);
+    set_scripted_buttons(tick);
+    update_particles();
+    host_telemetry_poll(false);
+}
+
+// Modo ocioso do escalonador: como idle_steps(), mas sem pular os ticks de botões e comandos
+// programados nem passar do --ticks (negativo: sem limite)
+static long host_tick_limit = -1;
+
+static uint32_t host_idle_steps(void) {
+    uint32_t idle = idle_steps();
+
+    for (int i = 0; i < press_count && idle; i++) {
+        if (presses[i].tick >= host_ticks && presses[i].tick - host_ticks < idle) idle = presses[i].tick - host_ticks;
+    }
+    for (int i = 0; i < command_count && idle; i++) {
+        if (commands[i].tick >= host_ticks && commands[i].tick - host_ticks < idle) idle = commands[i].tick - host_ticks;
+    }
+    if (host_tick_limit >= 0 && (uint64_t)(host_tick_limit - host_ticks) < idle) idle = (uint32_t)(host_tick_limit - host_ticks);
+    return idle;
+}
+
+static void host_skip_idle_steps(uint32_t steps) {
+    skip_idle_steps(steps);
+    host_ticks += steps; // Os ticks pulados contam para os botões e comandos programados
+}
+
+/************ Qui-quadrado de duas amostras ************/
+// Soma de (sqrt(B/A) a - sqrt(A/B) b)² / (a + b), com A e B os totais (com totais iguais, (a - b)² / (a + b));
+// 'df' recebe os graus de liberdade (bins não vazios - 1)
+static double two_sample_chi_square(const uint64_t *a, const uint64_t *b, int bins, int *df) {
+    double total_a = 0.0, total_b = 0.0, chi = 0.0;
+
+    for (int k = 0; k < bins; k++) {
+        total_a += (double)a[k];
+        total_b += (double)b[k];
+    }
+    *df = -1;
+    if (total_a == 0 || total_b == 0) return 0.0;
+
+    double ka = sqrt(total_b / total_a), kb = sqrt(total_a / total_b);
+    for (int k = 0; k < bins; k++) {
+        double x = (double)a[k], y = (double)b[k];
+        if (x + y == 0) continue;
+        chi += (ka * x - kb * y) * (ka * x - kb * y) / (x + y);
+        (*df)++;
+    }
+    return chi;
+}
+
+// Valor crítico a 99,9% pela aproximação de Wilson-Hilferty (z = 3,09)
+static double chi_square_critical_999(int df) {
+    if (df <= 0) return 0.0;
+    double h = 2.0 / (9.0 * df);
+    return df * pow(1.0 - h + 3.09 * sqrt(h), 3);
+}
+
+// Compara o histograma da placa da tela com as linhas "bin[k]=N" de outra execução (código de saída)
+static int compare_histogram(const char *path) {
+    static uint64_t other[MAX_BINS];
+    char line[128];
+    int bins = 0;
+    FILE *f = fopen(path, "r");
+
+    if (!f) {
+        perror(path);
+        return 1;
+    }
+    while (fgets(line, sizeof(line), f)) {
+        int k;
+        unsigned long long count;
+        if (sscanf(line, "bin[%d]=%llu", &k, &count) == 2 && k >= 0 && k < MAX_BINS) {
+            other[k] = count;
+            if (k + 1 > bins) bins = k + 1;
+        }
+    }
+    fclose(f);
+    if (bins != main_board.hist.num_bins) {
+        fprintf(stderr, "%s: %d bins, esta execução tem %d\n", path, bins, main_board.hist.num_bins);
+        return 1;
+    }
+
+    int df;
+    double chi = two_sample_chi_square(main_board.hist.bins, other, bins, &df);
+    double critical = chi_square_critical_999(df);
+    bool same_distribution = df <= 0 || chi <= critical;
+    printf("histogram_chi_square=%.4f df=%d critical_999=%.4f same_distribution=%d\n",
+           chi, df, critical, same_distribution);
+    return same_distribution ? 0 : 1;
+}
+
+/************ Conferência dos sorteadores ************/
+static phys_t compare_no_particles[4]; // As placas da conferência só usam o histograma
+
+// Sorteia 'balls' bolas numa placa nova com o sorteador dado e retorna o tempo gasto
+static double compare_run(galton_board_t *b, int sampler, uint64_t balls) {
+    galton_params_t params;
+    board_params_from_globals(&params);
+    params.sampler = sampler;
+    board_init(b, &params, compare_no_particles, 0, RNG_SEED ? RNG_SEED : 1, 0);
+
+    double start = wall_seconds();
+    for (uint64_t done = 0; done < balls;) {
+        int count = balls - done > (1u << 24) ? (1 << 24) : (int)(balls - done);
+        board_drop_fast_binomial(b, count);
+        done += (uint64_t)count;
+    }
+    return wall_seconds() - start;
+}
+
+// Vieses conferidos: P = 1/2 cabe numa rodada da comparação bit a bit; os demais (e os limites de 5% e
+// 95%) precisam de várias rodadas por decisão
+static const float compare_biases[] = {0.0f, 1.0f, 3.0f, 5.0f, 7.0f, 10.0f};
+
+static int compare_samplers(uint64_t balls) {
+    static galton_board_t boards[3];
+    static const char *names[3] = {"scalar", "simd", "lanes"};
+    static const int samplers[3] = {SAMPLER_SCALAR, SAMPLER_SIMD, SAMPLER_LANES};
+    int failures = 0;
+
+    printf("avx2=%d\n", binomial_simd_available());
+    for (size_t v = 0; v < sizeof(compare_biases) / sizeof(compare_biases[0]); v++) {
+        BALANCE_BIAS = compare_biases[v];
+        for (int s = 0; s < 3; s++) {
+            double elapsed = compare_run(&boards[s], samplers[s], balls);
+            printf("bias=%g %s:", BALANCE_BIAS, names[s]);
+            for (int k = 0; k < boards[s].hist.num_bins; k++) printf(" %llu", (unsigned long long)boards[s].hist.bins[k]);
+            printf(" balls_per_s=%.0f\n", elapsed > 0 ? balls / elapsed : 0.0);
+        }
+
+        // O kernel AVX2 e a versão portátil fazem as mesmas operações: contagens idênticas
+        bool identical = memcmp(boards[1].hist.bins, boards[2].hist.bins, sizeof(boards[1].hist.bins)) == 0;
+
+        int df;
+        double chi = two_sample_chi_square(boards[0].hist.bins, boards[1].hist.bins, boards[0].hist.num_bins, &df);
+        double critical = chi_square_critical_999(df);
+        bool same_distribution = df <= 0 || chi <= critical;
+
+        printf("bias=%g simd_lanes_identical=%d chi_square=%.4f df=%d critical_999=%.4f same_distribution=%d\n",
+               BALANCE_BIAS, identical, chi, df, critical, same_distribution);
+        if (!identical || !same_distribution) failures++;
+    }
+    return failures ? 1 : 0;
+}
+
+// Thread de renderização do modo --dual (faz o papel do núcleo 1)
+static atomic_bool render_thread_stop;
+static bool render_thread_print;
+static bool render_thread_paced; // Headless: o relógio virtual não espera, então a simulação espera a tela
+
+static void *render_thread_main(void *arg) {
+    (void)arg;
+    ssd1306_dma_init(); // Como no firmware, quem renderiza inicia o DMA
+
+    while (!atomic_load(&render_thread_stop)) {
+        if (!render_latest_snapshot()) {
+            sched_yield(); // Nada novo: cede o processador à simulação
+        } else if (render_thread_print) {
+            fputs("\033[H", stdout);
+            pico_shim_print_display();
+            fflush(stdout);
+        }
+    }
+    render_latest_snapshot(); // Desenha o que sobrou na fila
+    return NULL;
+}
+
+static galton_scheduler_t scheduler; // Passo fixo da física e taxa de quadros
+
+// Quadro do modo --dual: só publica a fotografia para a thread de renderização
+static void publish_snapshot(void) {
+    snapshot_queue_push_current(&snapshot_queue, scheduler.steps); // Nunca espera pela tela
+
+    // Sem essa espera a simulação virtual terminaria antes de a tela ver a maioria das fotografias
+    while (render_thread_paced && !snapshot_queue_drained(&snapshot_queue)) sched_yield();
+}
+
+// Quadro do modo interativo: desenha e mostra a tela emulada no terminal
+static void render_terminal(void) {
+    render_oled();
+    fputs("\033[H", stdout); // Volta o cursor ao topo para redesenhar
+    pico_shim_print_display();
+    fflush(stdout);
+}
+
+// Imprime os contadores do escalonador
+static void print_scheduler_stats(FILE *out) {
+    fprintf(out, "steps=%lu frames=%lu frames_skipped=%lu steps_dropped=%lu steps_idle=%lu idle_sleeps=%lu\n",
+            (unsigned long)scheduler.steps, (unsigned long)scheduler.frames,
+            (unsigned long)scheduler.frames_skipped, (unsigned long)scheduler.steps_dropped,
+            (unsigned long)scheduler.steps_idle, (unsigned long)scheduler.idle_sleeps);
+}
+
+// Simulação e renderização em threads separadas, trocando fotografias pela fila SPSC (código de saída)
+static int run_dual(bool headless, long ticks) {
+    pthread_t render_thread;
+
+    render_thread_print = !headless;
+    render_thread_paced = headless;
+    atomic_store(&render_thread_stop, false);
+    pthread_create(&render_thread, NULL, render_thread_main, NULL);
+
+    double start = wall_seconds();
+    scheduler_init(&scheduler, TICK_DELAY_MS, TARGET_FPS);
+    scheduler_set_idle(&scheduler, host_idle_steps, host_skip_idle_steps, input_pending);
+    host_tick_limit = ticks;
+    while (ticks < 0 || scheduler.steps < (unsigned long)ticks) {
+        scheduler_run_once(&scheduler, update_and_poll, publish_snapshot);
+    }
+    double elapsed = wall_seconds() - start;
+
+    atomic_store(&render_thread_stop, true);
+    pthread_join(render_thread, NULL);
+    host_telemetry_poll(true);
+
+    if (headless) print_histogram();
+    printf("ticks=%ld elapsed_s=%.6f frames_rendered=%lu snapshots_dropped=%lu out_of_order=%lu "
+           "geometry_changes=%lu geometry_regressions=%lu\n",
+           ticks, elapsed, (unsigned long)snapshot_queue.consumed, (unsigned long)snapshot_queue.dropped,
+           (unsigned long)snapshot_queue.out_of_order, (unsigned long)snapshot_queue.geometry_changes,
+           (unsigned long)snapshot_queue.geometry_regressions);
+    print_scheduler_stats(stdout);
+    return snapshot_queue.out_of_order || snapshot_queue.geometry_regressions ? 1 : 0;
+}
+
+int main(int argc, char **argv) {
+    bool headless = false;
+    bool virtual_clock = false;
+    bool dual = false;
+    long ticks = -1;
+    uint64_t compare_balls = 0;
+    const char *telemetry_path = NULL;
+    const char *histogram_path = NULL;
+    const char *record_path = NULL;
+    const char *replay_path = NULL;
+
+    for (int i = 1; i < argc; i++) {
+        if (strcmp(argv[i], "--headless") == 0) {
+            headless = true;
+        } else if (strcmp(argv[i], "--virtual") == 0) {
+            virtual_clock = true;
+        } else if (strcmp(argv[i], "--dual") == 0) {
+            dual = true;
+        } else if (strcmp(argv[i], "--fast") == 0) {
+            SIM_MODE = SIM_MODE_FAST_BINOMIAL;
+        } else if (strcmp(argv[i], "--sampler") == 0 && i + 1 < argc && sampler_from_name(argv[i + 1]) >= 0) {
+            BINOMIAL_SAMPLER = sampler_from_name(argv[++i]);
+        } else if (strcmp(argv[i], "--compare-samplers") == 0 && i + 1 < argc) {
+            compare_balls = strtoull(argv[++i], NULL, 0);
+        } else if (strcmp(argv[i], "--compare-histogram") == 0 && i + 1 < argc) {
+            histogram_path = argv[++i];
+        } else if (strcmp(argv[i], "--press") == 0 && i + 1 < argc && parse_press(argv[i + 1])) {
+            i++;
+        } else if (strcmp(argv[i], "--command") == 0 && i + 1 < argc && parse_command(argv[i + 1])) {
+            i++;
+        } else if (strcmp(argv[i], "--record") == 0 && i + 1 < argc) {
+            record_path = argv[++i];
+        } else if (strcmp(argv[i], "--replay") == 0 && i + 1 < argc) {
+            replay_path = argv[++i];
+        } else if (strcmp(argv[i], "--telemetry") == 0 && i + 1 < argc) {
+            telemetry_path = argv[++i];
+        } else if (strcmp(argv[i], "--seed") == 0 && i + 1 < argc) {
+            RNG_SEED = strtoull(argv[++i], NULL, 0);
+        } else if (strcmp(argv[i], "--balls") == 0 && i + 1 < argc) {
+            BALLS_PER_DROP = (int)strtol(argv[++i], NULL, 10);
+        } else if (strcmp(argv[i], "--ticks") == 0 && i + 1 < argc) {
+            ticks = strtol(argv[++i], NULL, 10);
+        } else if (strcmp(argv[i], "--fps") == 0 && i + 1 < argc) {
+            TARGET_FPS = (int)strtol(argv[++i], NULL, 10);
+        } else {
+            usage(argv[0]);
+            return 1;
+        }
+    }
+
+    if (compare_balls > 0) return compare_samplers(compare_balls);
+
+    if (replay_path) {
+        if (!load_replay(replay_path)) {
+            fprintf(stderr, "%s: gravação inválida\n", replay_path);
+            return 1;
+        }
+        const char *reason = replay_incompatible(&replay);
+        if (reason) {
+            fprintf(stderr, "%s: não reproduzível nesta compilação (%s)\n", replay_path, reason);
+            return 1;
+        }
+        ticks = replay.header.ticks; // Exatamente os ticks gravados
+        press_count = 0;             // Os botões vêm da gravação
+        command_count = 0;
+    } else if (record_path) {
+        replay.mode = REPLAY_RECORDING; // setup() grava a semente e os parâmetros
+    }
+
+    if (headless) {
+        if (ticks < 0) ticks = 10000;
+        virtual_clock = true;
+    }
+    if (virtual_clock) pico_shim_set_virtual_time(true); // sleep_ms não dorme: só avança o relógio
+
+    setup();
+
+    if (telemetry_path) {
+        telemetry_out = strcmp(telemetry_path, "-") == 0 ? stdout : fopen(telemetry_path, "wb");
+        if (!telemetry_out) {
+            perror(telemetry_path);
+            return 1;
+        }
+        main_board.telemetry = &telemetry_ring;
+    }
+
+    if (dual) {
+        int status = run_dual(headless, ticks);
+        profile_print_summary(stderr);
+        int replay_status = finish_replay(record_path);
+        return status ? status : replay_status;
+    }
+
+    if (headless) {
+        double start = wall_seconds();
+        for (long t = 0; t < ticks; t++) {
+            update_and_poll();
+            sleep_ms(TICK_DELAY_MS);
+        }
+        double elapsed = wall_seconds() - start;
+        host_telemetry_poll(true);
+
+        print_histogram();
+        printf("ticks=%ld elapsed_s=%.6f ticks_per_s=%.0f\n",
+               ticks, elapsed, elapsed > 0 ? ticks / elapsed : 0.0);
+        profile_print_summary(stderr);
+        int status = histogram_path ? compare_histogram(histogram_path) : 0;
+        int replay_status = finish_replay(record_path);
+        return status ? status : replay_status;
+    }
+
+    // Modo interativo: mesmo laço do firmware, com a tela emulada no terminal
+    ssd1306_dma_init();
+    scheduler_init(&scheduler, TICK_DELAY_MS, TARGET_FPS);
+    scheduler_set_idle(&scheduler, host_idle_steps, host_skip_idle_steps, input_pending);
+    host_tick_limit = ticks;
+    while (ticks < 0 || scheduler.steps < (unsigned long)ticks) {
+        scheduler_run_once(&scheduler, update_and_poll, render_terminal);
+    }
+    host_telemetry_poll(true);
+    print_scheduler_stats(stderr);
+    fprintf(stderr, "i2c_bytes=%llu i2c_transfers=%llu\n",
+            (unsigned long long)pico_shim_i2c_bytes(), (unsigned long long)pico_shim_i2c_transfers());
+    profile_print_summary(stderr);
+    return finish_replay(record_path);
+}
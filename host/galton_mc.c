@@ -0,0 +1,187 @@
+// Monte Carlo nativo em várias threads: bilhões de bolas no modo binomial
+//
+// Uso: galton_mc [--balls N] [--threads T] [--chunk C] [--bias B] [--sampler NOME] [--seed S]
+//   --balls N    Total de bolas (padrão: 1000000000)
+//   --threads T  Threads de trabalho (padrão: número de processadores)
+//   --chunk C    Bolas por bloco de trabalho (padrão: 1048576)
+//   --bias B     BALANCE_BIAS de 0 a 10 (padrão: 5)
+//   --sampler    scalar (padrão), simd ou lanes (ver galton_binomial.h)
+//   --seed S     Semente (padrão: 1)
+//
+// O total é dividido em blocos. Cada thread tem uma placa própria (gerador e histograma
+// privados, sem contadores compartilhados) e começa com uma faixa contígua de blocos;
+// quem termina a sua rouba metade do que resta na faixa de outra thread. O gerador é
+// semeado por bloco com (semente, índice do bloco), então o resultado não depende de
+// qual thread executou cada bloco: a mesma semente dá as mesmas contagens com qualquer
+// número de threads. Ao final os histogramas são somados em ordem fixa.
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <pthread.h>
+#include <stdatomic.h>
+#include <unistd.h>
+#include "inc/galton_board.h"
+
+#define MC_MAX_THREADS 256
+
+/* Faixa [begin, end) de blocos de uma thread, num único atômico de 64 bits */
+typedef struct {
+    _Alignas(64) atomic_uint_least64_t range; // begin nos 32 bits baixos, end nos altos
+    _Alignas(64) galton_board_t board;        // Gerador e histograma privados, fora da linha de 'range'
+    uint64_t chunks_done;                     // Blocos executados por esta thread
+    uint64_t chunks_stolen;                   // Blocos obtidos de outras threads
+} mc_worker_t;
+
+static mc_worker_t mc_workers[MC_MAX_THREADS];
+static phys_t mc_no_particles[4];  // O sorteio binomial não integra bolas: placas com capacidade 0
+static int mc_threads;
+static uint64_t mc_total_balls;
+static uint64_t mc_chunk_balls;
+static uint64_t mc_seed;
+
+static inline uint64_t mc_pack(uint32_t begin, uint32_t end) {
+    return (uint64_t)begin | ((uint64_t)end << 32);
+}
+
+// Dono: retira o primeiro bloco da própria faixa
+static bool mc_pop(mc_worker_t *w, uint32_t *chunk) {
+    uint64_t r = atomic_load(&w->range);
+    for (;;) {
+        uint32_t begin = (uint32_t)r, end = (uint32_t)(r >> 32);
+        if (begin >= end) return false;
+        if (atomic_compare_exchange_weak(&w->range, &r, mc_pack(begin + 1, end))) {
+            *chunk = begin;
+            return true;
+        }
+    }
+}
+
+// Ladrão: toma a metade final da faixa de 'victim' e a instala como faixa própria
+static bool mc_steal(mc_worker_t *self, mc_worker_t *victim) {
+    uint64_t r = atomic_load(&victim->range);
+    for (;;) {
+        uint32_t begin = (uint32_t)r, end = (uint32_t)(r >> 32);
+        if (begin >= end) return false;
+        uint32_t mid = end - (end - begin + 1) / 2; // Leva ao menos um bloco
+        if (atomic_compare_exchange_weak(&victim->range, &r, mc_pack(begin, mid))) {
+            self->chunks_stolen += end - mid;
+            atomic_store(&self->range, mc_pack(mid, end));
+            return true;
+        }
+    }
+}
+
+static void *mc_worker_main(void *arg) {
+    mc_worker_t *self = arg;
+    int id = (int)(self - mc_workers);
+
+    for (;;) {
+        uint32_t chunk;
+        while (mc_pop(self, &chunk)) {
+            uint64_t first = (uint64_t)chunk * mc_chunk_balls;
+            uint64_t count = first + mc_chunk_balls <= mc_total_balls ? mc_chunk_balls : mc_total_balls - first;
+
+            board_reseed(&self->board, mc_seed, chunk); // Fluxo do bloco, não da thread: resultado reprodutível
+            board_drop_fast_binomial(&self->board, (int)count);
+            self->chunks_done++;
+        }
+
+        // Faixa vazia: procura trabalho nas outras threads, a partir da vizinha
+        bool stole = false;
+        for (int k = 1; k < mc_threads && !stole; k++) {
+            stole = mc_steal(self, &mc_workers[(id + k) % mc_threads]);
+        }
+        if (!stole) break; // Nada em lugar nenhum: todas as faixas estão vazias
+    }
+    return NULL;
+}
+
+static double wall_seconds(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec + ts.tv_nsec / 1e9;
+}
+
+static void usage(const char *prog) {
+    fprintf(stderr, "Uso: %s [--balls N] [--threads T] [--chunk C] [--bias B] [--sampler scalar|simd|lanes] [--seed S]\n", prog);
+}
+
+int main(int argc, char **argv) {
+    mc_total_balls = 1000000000ull;
+    mc_chunk_balls = 1u << 20;
+    mc_threads = (int)sysconf(_SC_NPROCESSORS_ONLN);
+    mc_seed = 1;
+
+    for (int i = 1; i < argc; i++) {
+        if (strcmp(argv[i], "--balls") == 0 && i + 1 < argc) {
+            mc_total_balls = strtoull(argv[++i], NULL, 0);
+        } else if (strcmp(argv[i], "--threads") == 0 && i + 1 < argc) {
+            mc_threads = (int)strtol(argv[++i], NULL, 10);
+        } else if (strcmp(argv[i], "--chunk") == 0 && i + 1 < argc) {
+            mc_chunk_balls = strtoull(argv[++i], NULL, 0);
+        } else if (strcmp(argv[i], "--bias") == 0 && i + 1 < argc) {
+            BALANCE_BIAS = strtof(argv[++i], NULL);
+        } else if (strcmp(argv[i], "--sampler") == 0 && i + 1 < argc && sampler_from_name(argv[i + 1]) >= 0) {
+            BINOMIAL_SAMPLER = sampler_from_name(argv[++i]);
+        } else if (strcmp(argv[i], "--seed") == 0 && i + 1 < argc) {
+            mc_seed = strtoull(argv[++i], NULL, 0);
+        } else {
+            usage(argv[0]);
+            return 1;
+        }
+    }
+    if (mc_threads < 1) mc_threads = 1;
+    if (mc_threads > MC_MAX_THREADS) mc_threads = MC_MAX_THREADS;
+    if (mc_chunk_balls == 0 || mc_chunk_balls > INT32_MAX) mc_chunk_balls = 1u << 20;
+
+    uint64_t num_chunks = (mc_total_balls + mc_chunk_balls - 1) / mc_chunk_balls;
+    if (num_chunks > UINT32_MAX) {
+        fprintf(stderr, "Blocos demais: aumente --chunk\n");
+        return 1;
+    }
+
+    // Cada thread recebe uma placa sem partículas (só o sorteio binomial) e uma faixa contígua de blocos
+    galton_params_t params;
+    SIM_MODE = SIM_MODE_FAST_BINOMIAL;
+    board_params_from_globals(&params);
+    for (int t = 0; t < mc_threads; t++) {
+        mc_worker_t *w = &mc_workers[t];
+        board_init(&w->board, &params, mc_no_particles, 0, mc_seed, 0);
+        w->chunks_done = 0;
+        w->chunks_stolen = 0;
+        atomic_store(&w->range, mc_pack((uint32_t)(num_chunks * t / mc_threads),
+                                        (uint32_t)(num_chunks * (t + 1) / mc_threads)));
+    }
+
+    double start = wall_seconds();
+    pthread_t threads[MC_MAX_THREADS];
+    for (int t = 1; t < mc_threads; t++) pthread_create(&threads[t], NULL, mc_worker_main, &mc_workers[t]);
+    mc_worker_main(&mc_workers[0]); // A thread principal também trabalha
+    for (int t = 1; t < mc_threads; t++) pthread_join(threads[t], NULL);
+    double elapsed = wall_seconds() - start;
+
+    // Junta os histogramas em ordem fixa (somas inteiras) e calcula as estatísticas uma vez
+    galton_board_t total;
+    board_init(&total, &params, mc_no_particles, 0, mc_seed, 0);
+    for (int k = 0; k < total.hist.num_bins; k++) {
+        uint64_t sum = 0;
+        for (int t = 0; t < mc_threads; t++) sum += mc_workers[t].board.hist.bins[k];
+        histogram_add(&total.hist, k, sum);
+    }
+
+    const galton_stats_t *s = &total.hist.stats;
+    printf("total_particles=%llu\n", (unsigned long long)s->count);
+    for (int k = 0; k < total.hist.num_bins; k++) printf("bin[%d]=%llu\n", k, (unsigned long long)total.hist.bins[k]);
+    printf("mean=%.6f variance=%.6f skewness=%.6f chi_square=%.6f\n",
+           stats_mean(s), stats_variance(s), stats_skewness(s), stats_chi_square(s));
+    printf("threads=%d chunks=%llu elapsed_s=%.3f balls_per_s=%.0f\n", mc_threads, (unsigned long long)num_chunks,
+           elapsed, elapsed > 0 ? (double)mc_total_balls / elapsed : 0.0);
+
+    for (int t = 0; t < mc_threads; t++) {
+        fprintf(stderr, "thread[%d] chunks=%llu stolen=%llu\n", t, (unsigned long long)mc_workers[t].chunks_done,
+                (unsigned long long)mc_workers[t].chunks_stolen);
+    }
+    return 0;
+}
@@ -0,0 +1,8 @@
+// Shim de "hardware/adc.h": o projeto não usa o ADC, só inclui o cabeçalho
+
+#ifndef PICO_SHIM_ADC_H
+#define PICO_SHIM_ADC_H
+
+#include "pico.h"
+
+#endif
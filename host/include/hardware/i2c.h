@@ -0,0 +1,45 @@
+// Shim de "hardware/i2c.h" para o host
+// As escritas são entregues a um emulador simples do SSD1306 (ver pico_shim.c),
+// tanto por i2c_write_blocking quanto por DMA no registrador data_cmd.
+
+#ifndef PICO_SHIM_I2C_H
+#define PICO_SHIM_I2C_H
+
+#include "pico.h"
+
+#define I2C_IC_DATA_CMD_STOP_BITS    0x00000200u // Encerra a transação após este byte
+#define I2C_IC_DATA_CMD_RESTART_BITS 0x00000400u // Reinicia a transação antes deste byte
+#define I2C_IC_STATUS_ACTIVITY_BITS  0x00000001u // Controlador em atividade no barramento
+#define I2C_IC_STATUS_TFE_BITS       0x00000004u // FIFO de TX vazio
+
+/* Registradores usados pelo projeto */
+typedef struct {
+    volatile uint32_t enable;
+    volatile uint32_t tar;
+    volatile uint32_t data_cmd;
+    volatile uint32_t status;   // No shim cada envio termina na hora: FIFO sempre vazio e sem atividade
+} i2c_hw_t;
+
+typedef struct i2c_inst {
+    i2c_hw_t hw;
+    unsigned int index;
+} i2c_inst_t;
+
+extern i2c_inst_t i2c0_inst;
+extern i2c_inst_t i2c1_inst;
+
+#define i2c0 (&i2c0_inst)
+#define i2c1 (&i2c1_inst)
+
+unsigned int i2c_init(i2c_inst_t *i2c, unsigned int baudrate);
+int i2c_write_blocking(i2c_inst_t *i2c, uint8_t addr, const uint8_t *src, size_t len, bool nostop);
+
+static inline i2c_hw_t *i2c_get_hw(i2c_inst_t *i2c) {
+    return &i2c->hw;
+}
+
+static inline unsigned int i2c_get_dreq(i2c_inst_t *i2c, bool is_tx) {
+    return 32 + 2 * i2c->index + (is_tx ? 0 : 1); // DREQ_I2C0_TX = 32 no RP2040
+}
+
+#endif
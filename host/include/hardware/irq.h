@@ -0,0 +1,18 @@
+// Shim de "hardware/irq.h" para o host
+// Os tratadores registrados são chamados diretamente pelo shim (ex.: fim de DMA).
+
+#ifndef PICO_SHIM_IRQ_H
+#define PICO_SHIM_IRQ_H
+
+#include "pico.h"
+
+#define DMA_IRQ_0 11
+#define IO_IRQ_BANK0 13
+#define NUM_IRQS 32
+
+typedef void (*irq_handler_t)(void);
+
+void irq_set_exclusive_handler(unsigned int num, irq_handler_t handler);
+void irq_set_enabled(unsigned int num, bool enabled);
+
+#endif
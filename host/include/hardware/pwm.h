@@ -0,0 +1,8 @@
+// Shim de "hardware/pwm.h": o projeto não usa PWM, só inclui o cabeçalho
+
+#ifndef PICO_SHIM_PWM_H
+#define PICO_SHIM_PWM_H
+
+#include "pico.h"
+
+#endif
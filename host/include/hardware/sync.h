@@ -0,0 +1,11 @@
+// Shim de "hardware/sync.h" para o host: sem WFE/SEV, as esperas viram laços ativos
+
+#ifndef PICO_SHIM_SYNC_H
+#define PICO_SHIM_SYNC_H
+
+#include "pico.h"
+
+static inline void __wfe(void) {}
+static inline void __sev(void) {}
+
+#endif
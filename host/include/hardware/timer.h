@@ -0,0 +1,11 @@
+// Shim de "hardware/timer.h" para o host: contador de microssegundos do relógio do shim
+
+#ifndef PICO_SHIM_TIMER_H
+#define PICO_SHIM_TIMER_H
+
+#include "pico.h"
+
+uint32_t time_us_32(void); // 32 bits baixos (volta a zero a cada ~71 minutos, como no RP2040)
+uint64_t time_us_64(void);
+
+#endif
@@ -0,0 +1,17 @@
+// Shim mínimo do SDK da Pico para compilação nativa (host Linux)
+// Define apenas os tipos e macros usados pelo projeto Galton Board.
+
+#ifndef PICO_SHIM_PICO_H
+#define PICO_SHIM_PICO_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include <assert.h>
+
+#define _u(x) x ## u                                   // Literal sem sinal, como no SDK
+#define count_of(a) (sizeof(a) / sizeof((a)[0]))      // Número de elementos de um vetor
+
+static inline void tight_loop_contents(void) {}        // Corpo vazio de laços de espera
+
+#endif
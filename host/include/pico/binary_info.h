@@ -0,0 +1,8 @@
+// Shim de "pico/binary_info.h": metadados de binário não existem no host
+
+#ifndef PICO_SHIM_BINARY_INFO_H
+#define PICO_SHIM_BINARY_INFO_H
+
+#define bi_decl(...)
+
+#endif
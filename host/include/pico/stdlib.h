@@ -0,0 +1,12 @@
+// Shim de "pico/stdlib.h" para o host: reúne tempo, GPIO e stdio
+
+#ifndef PICO_SHIM_STDLIB_H
+#define PICO_SHIM_STDLIB_H
+
+#include "pico.h"
+#include "pico/time.h"
+#include "hardware/gpio.h"
+
+bool stdio_init_all(void); // Sem USB no host: a saída padrão já é o terminal
+
+#endif
@@ -0,0 +1,22 @@
+// Shim de "pico/time.h" para o host
+// O relógio pode ser real (CLOCK_MONOTONIC) ou virtual (avança só em sleep_ms/sleep_until),
+// ver pico_shim_set_virtual_time() em pico_shim.h.
+
+#ifndef PICO_SHIM_TIME_H
+#define PICO_SHIM_TIME_H
+
+#include "pico.h"
+#include "hardware/timer.h"
+
+typedef uint64_t absolute_time_t; // Microssegundos desde o "boot" do processo
+
+absolute_time_t get_absolute_time(void);
+int64_t absolute_time_diff_us(absolute_time_t from, absolute_time_t to);
+uint64_t to_us_since_boot(absolute_time_t t);
+void sleep_ms(uint32_t ms);
+void sleep_us(uint64_t us);
+void sleep_until(absolute_time_t target);
+absolute_time_t delayed_by_us(absolute_time_t t, uint64_t us);
+bool best_effort_wfe_or_timeout(absolute_time_t timeout_timestamp); // Host: dorme até o prazo e retorna true
+
+#endif
@@ -0,0 +1,20 @@
+// Controles exclusivos do shim do host (não existem no SDK da Pico)
+
+#ifndef PICO_SHIM_H
+#define PICO_SHIM_H
+
+#include "pico.h"
+
+/* Relógio */
+void pico_shim_set_virtual_time(bool enabled); // true: sleep_ms só avança o relógio, sem dormir
+
+/* GPIO */
+void pico_shim_set_gpio(unsigned int gpio, bool level); // Força o nível lido por gpio_get
+
+/* Display SSD1306 emulado */
+const uint8_t *pico_shim_display_ram(void); // GDDRAM emulada (8 páginas x 128 colunas)
+uint64_t pico_shim_i2c_bytes(void);         // Total de bytes escritos no barramento I2C
+uint64_t pico_shim_i2c_transfers(void);     // Total de transações I2C
+void pico_shim_print_display(void);         // Desenha a GDDRAM no terminal
+
+#endif
@@ -0,0 +1,363 @@
+// Implementação do shim do SDK da Pico para o host Linux
+// Tempo (real ou virtual), GPIO em memória, DMA/IRQ síncronos e um emulador simples do SSD1306 no I2C.
+
+#define _POSIX_C_SOURCE 200809L
+
+#include <stdio.h>
+#include <string.h>
+#include <time.h>
+#include "pico/stdlib.h"
+#include "hardware/i2c.h"
+#include "hardware/dma.h"
+#include "hardware/irq.h"
+#include "pico_shim.h"
+
+#define SHIM_NUM_GPIOS 30      // GPIOs do RP2040
+#define SHIM_OLED_WIDTH 128    // Colunas da GDDRAM
+#define SHIM_OLED_PAGES 8      // Páginas de 8 linhas
+
+/************ Relógio ************/
+static bool virtual_time = false;      // Relógio virtual (modo headless)
+static uint64_t virtual_now_us = 0;    // Tempo virtual acumulado
+static uint64_t boot_ns = 0;           // Instante do "boot" no relógio real
+
+static uint64_t monotonic_ns(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000ull + (uint64_t)ts.tv_nsec;
+}
+
+void pico_shim_set_virtual_time(bool enabled) {
+    virtual_time = enabled;
+    virtual_now_us = 0;
+}
+
+absolute_time_t get_absolute_time(void) {
+    if (virtual_time) return virtual_now_us;
+    if (boot_ns == 0) boot_ns = monotonic_ns();
+    return (monotonic_ns() - boot_ns) / 1000;
+}
+
+int64_t absolute_time_diff_us(absolute_time_t from, absolute_time_t to) {
+    return (int64_t)(to - from);
+}
+
+uint64_t to_us_since_boot(absolute_time_t t) {
+    return t;
+}
+
+void sleep_us(uint64_t us) {
+    if (virtual_time) {
+        virtual_now_us += us; // Não dorme: apenas avança o relógio virtual
+        return;
+    }
+    struct timespec ts = { (time_t)(us / 1000000), (long)(us % 1000000) * 1000 };
+    nanosleep(&ts, NULL);
+}
+
+void sleep_ms(uint32_t ms) {
+    sleep_us((uint64_t)ms * 1000);
+}
+
+void sleep_until(absolute_time_t target) {
+    absolute_time_t now = get_absolute_time();
+    if (target > now) sleep_us(target - now); // No relógio virtual, salta direto para o prazo
+}
+
+bool best_effort_wfe_or_timeout(absolute_time_t timeout_timestamp) {
+    sleep_until(timeout_timestamp); // Sem WFE no host: as "interrupções" dos botões vêm da mesma thread
+    return true;
+}
+
+uint32_t time_us_32(void) {
+    return (uint32_t)get_absolute_time();
+}
+
+uint64_t time_us_64(void) {
+    return get_absolute_time();
+}
+
+absolute_time_t delayed_by_us(absolute_time_t t, uint64_t us) {
+    return t + us;
+}
+
+bool stdio_init_all(void) {
+    return true;
+}
+
+/************ GPIO ************/
+static bool gpio_level[SHIM_NUM_GPIOS];
+static uint32_t gpio_irq_events[SHIM_NUM_GPIOS]; // Bordas com interrupção habilitada (GPIO_IRQ_EDGE_*)
+static gpio_irq_callback_t gpio_irq_callback;    // Um callback para todos os pinos, como no SDK
+
+void gpio_init(unsigned int gpio) { (void)gpio; }
+void gpio_set_dir(unsigned int gpio, bool out) { (void)gpio; (void)out; }
+void gpio_set_function(unsigned int gpio, enum gpio_function fn) { (void)gpio; (void)fn; }
+
+void gpio_pull_up(unsigned int gpio) {
+    if (gpio < SHIM_NUM_GPIOS) gpio_level[gpio] = true; // Botão solto lê nível alto
+}
+
+void gpio_put(unsigned int gpio, bool value) {
+    if (gpio < SHIM_NUM_GPIOS) gpio_level[gpio] = value;
+}
+
+bool gpio_get(unsigned int gpio) {
+    return gpio < SHIM_NUM_GPIOS ? gpio_level[gpio] : false;
+}
+
+void gpio_set_irq_enabled(unsigned int gpio, uint32_t event_mask, bool enabled) {
+    if (gpio >= SHIM_NUM_GPIOS) return;
+    if (enabled) gpio_irq_events[gpio] |= event_mask;
+    else gpio_irq_events[gpio] &= ~event_mask;
+}
+
+void gpio_set_irq_enabled_with_callback(unsigned int gpio, uint32_t event_mask, bool enabled, gpio_irq_callback_t callback) {
+    gpio_set_irq_enabled(gpio, event_mask, enabled);
+    if (enabled) gpio_irq_callback = callback;
+}
+
+void pico_shim_set_gpio(unsigned int gpio, bool level) {
+    if (gpio >= SHIM_NUM_GPIOS) return;
+    bool previous = gpio_level[gpio];
+    gpio_put(gpio, level);
+    if (previous == level) return;
+
+    // Borda no pino: a "interrupção" roda aqui mesmo, na thread que mexeu no botão
+    uint32_t edge = level ? GPIO_IRQ_EDGE_RISE : GPIO_IRQ_EDGE_FALL;
+    if ((gpio_irq_events[gpio] & edge) && gpio_irq_callback) gpio_irq_callback(gpio, edge);
+}
+
+/************ I2C + emulador do SSD1306 ************/
+i2c_inst_t i2c0_inst = {.hw.status = I2C_IC_STATUS_TFE_BITS, .index = 0};
+i2c_inst_t i2c1_inst = {.hw.status = I2C_IC_STATUS_TFE_BITS, .index = 1};
+
+static uint8_t gddram[SHIM_OLED_PAGES * SHIM_OLED_WIDTH]; // Memória de vídeo emulada
+static uint8_t col_start = 0, col_end = SHIM_OLED_WIDTH - 1;
+static uint8_t page_start = 0, page_end = SHIM_OLED_PAGES - 1;
+static uint8_t col = 0, page = 0;          // Ponteiro de escrita atual
+static uint8_t pending_cmd = 0;            // Comando aguardando argumentos
+static int pending_args = 0;               // Argumentos que ainda faltam
+static uint8_t cmd_args[6];
+static int cmd_argc = 0;
+static uint64_t i2c_bytes = 0;
+static uint64_t i2c_transfers = 0;
+
+// Número de bytes de argumento de cada comando do SSD1306 (0 para os demais)
+static int ssd1306_arg_count(uint8_t cmd) {
+    switch (cmd) {
+        case 0x20: case 0x81: case 0x8D: case 0xA8: case 0xD3:
+        case 0xD5: case 0xD9: case 0xDA: case 0xDB:
+            return 1;
+        case 0x21: case 0x22:
+            return 2;
+        case 0x29: case 0x2A:
+            return 5;
+        case 0x26: case 0x27:
+            return 6;
+        default:
+            return 0;
+    }
+}
+
+static void ssd1306_command_byte(uint8_t byte) {
+    if (pending_args > 0) {
+        cmd_args[cmd_argc++] = byte;
+        if (--pending_args > 0) return;
+
+        if (pending_cmd == 0x21) { // Endereço de coluna
+            col_start = cmd_args[0] % SHIM_OLED_WIDTH;
+            col_end = cmd_args[1] % SHIM_OLED_WIDTH;
+            col = col_start;
+        } else if (pending_cmd == 0x22) { // Endereço de página
+            page_start = cmd_args[0] % SHIM_OLED_PAGES;
+            page_end = cmd_args[1] % SHIM_OLED_PAGES;
+            page = page_start;
+        }
+        return;
+    }
+
+    pending_cmd = byte;
+    pending_args = ssd1306_arg_count(byte);
+    cmd_argc = 0;
+}
+
+static void ssd1306_data_byte(uint8_t byte) {
+    gddram[page * SHIM_OLED_WIDTH + col] = byte;
+
+    // Modo de endereçamento horizontal: avança coluna e, no fim, a página
+    if (col == col_end) {
+        col = col_start;
+        page = (page == page_end) ? page_start : page + 1;
+    } else {
+        col++;
+    }
+}
+
+unsigned int i2c_init(i2c_inst_t *i2c, unsigned int baudrate) {
+    (void)i2c;
+    return baudrate;
+}
+
+// Uma transação completa (START ... STOP) endereçada ao display
+static void i2c_transaction(const uint8_t *src, size_t len) {
+    if (len == 0) return;
+
+    i2c_transfers++;
+    i2c_bytes += len;
+
+    uint8_t control = src[0];
+    if (control == 0x80) {            // Co=1, D/C=0: um único byte de comando
+        if (len > 1) ssd1306_command_byte(src[1]);
+    } else if (control & 0x40) {      // D/C=1: fluxo de dados para a GDDRAM
+        for (size_t i = 1; i < len; i++) ssd1306_data_byte(src[i]);
+    } else {                          // Co=0, D/C=0: fluxo de comandos
+        for (size_t i = 1; i < len; i++) ssd1306_command_byte(src[i]);
+    }
+}
+
+int i2c_write_blocking(i2c_inst_t *i2c, uint8_t addr, const uint8_t *src, size_t len, bool nostop) {
+    (void)i2c; (void)addr; (void)nostop;
+    i2c_transaction(src, len);
+    return (int)len;
+}
+
+/************ DMA e interrupções ************/
+typedef struct {
+    bool claimed;
+    dma_channel_config config;
+    volatile void *write_addr;
+    bool irq0_enabled;
+    bool irq0_status;
+} shim_dma_channel_t;
+
+static shim_dma_channel_t dma_channels[NUM_DMA_CHANNELS];
+static irq_handler_t irq_handlers[NUM_IRQS];
+static bool irq_enabled[NUM_IRQS];
+static uint8_t dma_i2c_pending[1 + SHIM_OLED_PAGES * SHIM_OLED_WIDTH + 64]; // Transação montada pelo DMA
+static size_t dma_i2c_length = 0;
+
+void irq_set_exclusive_handler(unsigned int num, irq_handler_t handler) {
+    if (num < NUM_IRQS) irq_handlers[num] = handler;
+}
+
+void irq_set_enabled(unsigned int num, bool enabled) {
+    if (num < NUM_IRQS) irq_enabled[num] = enabled;
+}
+
+int dma_claim_unused_channel(bool required) {
+    for (int ch = 0; ch < NUM_DMA_CHANNELS; ch++) {
+        if (!dma_channels[ch].claimed) {
+            dma_channels[ch].claimed = true;
+            return ch;
+        }
+    }
+    assert(!required);
+    return -1;
+}
+
+dma_channel_config dma_channel_get_default_config(unsigned int channel) {
+    (void)channel;
+    return (dma_channel_config){DMA_SIZE_32, true, false, 0x3f};
+}
+
+void channel_config_set_transfer_data_size(dma_channel_config *c, enum dma_channel_transfer_size size) { c->size = size; }
+void channel_config_set_read_increment(dma_channel_config *c, bool incr) { c->read_increment = incr; }
+void channel_config_set_write_increment(dma_channel_config *c, bool incr) { c->write_increment = incr; }
+void channel_config_set_dreq(dma_channel_config *c, unsigned int dreq) { c->dreq = dreq; }
+
+void dma_channel_configure(unsigned int channel, const dma_channel_config *config, volatile void *write_addr,
+                           const volatile void *read_addr, unsigned int transfer_count, bool trigger) {
+    dma_channels[channel].config = *config;
+    dma_channels[channel].write_addr = write_addr;
+    if (trigger) dma_channel_transfer_from_buffer_now(channel, read_addr, transfer_count);
+}
+
+// Palavra escrita em IC_DATA_CMD: acumula o byte e entrega a transação no STOP
+static void i2c_data_cmd_write(uint32_t word) {
+    if (word & I2C_IC_DATA_CMD_RESTART_BITS) dma_i2c_length = 0;
+    if (dma_i2c_length < sizeof(dma_i2c_pending)) dma_i2c_pending[dma_i2c_length++] = (uint8_t)word;
+    if (word & I2C_IC_DATA_CMD_STOP_BITS) {
+        i2c_transaction(dma_i2c_pending, dma_i2c_length);
+        dma_i2c_length = 0;
+    }
+}
+
+void dma_channel_transfer_from_buffer_now(unsigned int channel, const volatile void *read_addr, uint32_t transfer_count) {
+    shim_dma_channel_t *ch = &dma_channels[channel];
+    bool to_i2c = ch->write_addr == &i2c0_inst.hw.data_cmd || ch->write_addr == &i2c1_inst.hw.data_cmd;
+
+    // O host conclui a transferência imediatamente
+    for (uint32_t i = 0; i < transfer_count; i++) {
+        uint32_t word;
+        switch (ch->config.size) {
+            case DMA_SIZE_8:  word = ((const volatile uint8_t *)read_addr)[ch->config.read_increment ? i : 0]; break;
+            case DMA_SIZE_16: word = ((const volatile uint16_t *)read_addr)[ch->config.read_increment ? i : 0]; break;
+            default:          word = ((const volatile uint32_t *)read_addr)[ch->config.read_increment ? i : 0]; break;
+        }
+
+        if (to_i2c) {
+            i2c_data_cmd_write(word);
+        } else if (ch->config.size == DMA_SIZE_8) {
+            ((volatile uint8_t *)ch->write_addr)[ch->config.write_increment ? i : 0] = (uint8_t)word;
+        } else if (ch->config.size == DMA_SIZE_16) {
+            ((volatile uint16_t *)ch->write_addr)[ch->config.write_increment ? i : 0] = (uint16_t)word;
+        } else {
+            ((volatile uint32_t *)ch->write_addr)[ch->config.write_increment ? i : 0] = word;
+        }
+    }
+
+    // Sinaliza o fim e chama o tratador da interrupção, como faria o hardware
+    if (ch->irq0_enabled) {
+        ch->irq0_status = true;
+        if (irq_enabled[DMA_IRQ_0] && irq_handlers[DMA_IRQ_0]) irq_handlers[DMA_IRQ_0]();
+    }
+}
+
+bool dma_channel_is_busy(unsigned int channel) {
+    (void)channel;
+    return false;
+}
+
+void dma_channel_wait_for_finish_blocking(unsigned int channel) {
+    (void)channel;
+}
+
+void dma_channel_set_irq0_enabled(unsigned int channel, bool enabled) {
+    dma_channels[channel].irq0_enabled = enabled;
+}
+
+bool dma_channel_get_irq0_status(unsigned int channel) {
+    return dma_channels[channel].irq0_status;
+}
+
+void dma_channel_acknowledge_irq0(unsigned int channel) {
+    dma_channels[channel].irq0_status = false;
+}
+
+const uint8_t *pico_shim_display_ram(void) {
+    return gddram;
+}
+
+uint64_t pico_shim_i2c_bytes(void) {
+    return i2c_bytes;
+}
+
+uint64_t pico_shim_i2c_transfers(void) {
+    return i2c_transfers;
+}
+
+// Desenha a GDDRAM com meio-blocos: cada caractere representa 2 linhas de pixels
+void pico_shim_print_display(void) {
+    static const char *cells[4] = {" ", "▀", "▄", "█"};
+    const int height = SHIM_OLED_PAGES * 8;
+
+    for (int y = 0; y < height; y += 2) {
+        for (int x = 0; x < SHIM_OLED_WIDTH; x++) {
+            int top = (gddram[(y / 8) * SHIM_OLED_WIDTH + x] >> (y % 8)) & 1;
+            int bottom = (gddram[((y + 1) / 8) * SHIM_OLED_WIDTH + x] >> ((y + 1) % 8)) & 1;
+            fputs(cells[top | (bottom << 1)], stdout);
+        }
+        fputc('\n', stdout);
+    }
+}
@@ -0,0 +1,40 @@
+// Sorteio binomial bit a bit em paralelo (modo rápido)
+//
+// Em vez de uma chamada do gerador por decisão, 8 fluxos xoshiro128++ intercalados geram
+// 256 bits por rodada e cada byte vira uma bola: seus PIN_ROWS bits baixos são as decisões
+// e o bin é o popcount do byte. Com viés, a comparação "aleatório < limiar" é feita bit a
+// bit para as 256 decisões ao mesmo tempo (do bit mais alto do limiar para o mais baixo,
+// parando quando todas estão decididas), o que dá P = limiar / 2^32 exatamente.
+//
+// No host x86 o laço usa AVX2 quando o processador tem; senão, e no RP2040, a versão
+// portátil faz exatamente as mesmas operações em 8 palavras de 32 bits (mesmo resultado).
+
+#ifndef GALTON_BINOMIAL_H
+#define GALTON_BINOMIAL_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "inc/galton_rng.h"
+
+#define RNG_LANES 8           // Fluxos intercalados (um registrador AVX2 de 256 bits)
+#define BINOMIAL_MAX_ROWS 8   // Uma bola por byte: até 8 decisões
+
+/* Sorteadores do modo rápido */
+#define SAMPLER_SCALAR 0  // rng_count_decisions: uma decisão por número aleatório (popcount a 50%)
+#define SAMPLER_SIMD 1    // Bit a bit em paralelo, com AVX2 se disponível
+#define SAMPLER_LANES 2   // Bit a bit em paralelo, sempre pela versão portátil (para conferência)
+
+/* 8 fluxos xoshiro128++ em estrutura de vetores: s[k][lane] */
+typedef struct {
+    uint32_t s[4][RNG_LANES];
+} galton_rng_lanes_t;
+
+void rng_lanes_seed(galton_rng_lanes_t *r, uint64_t seed, uint32_t stream); // Fluxos disjuntos por saltos de 2^64
+bool binomial_simd_available(void); // true se o host tem AVX2
+int sampler_from_name(const char *name); // "scalar", "simd" ou "lanes"; -1 se desconhecido
+
+// Soma a counts[k] (k = 0..rows) quantas de 'balls' bolas tiveram k decisões verdadeiras
+void binomial_sample(galton_rng_lanes_t *r, uint32_t threshold, int rows, uint64_t balls,
+                     uint64_t *counts, bool allow_simd);
+
+#endif
@@ -0,0 +1,100 @@
+// Contexto de uma placa de Galton: parâmetros, geometria, gerador, partículas e histograma
+//
+// A placa da tela é main_board, alimentada a cada tick pelas variáveis globais ajustáveis
+// (GRAVITY, BALANCE_BIAS, ...). Outras placas, como as de uma varredura de parâmetros
+// (galton_sweep.h), são independentes: cada uma tem seu fluxo aleatório e seu histograma.
+
+#ifndef GALTON_BOARD_H
+#define GALTON_BOARD_H
+
+#include "inc/galton_config.h"
+#include "inc/galton_stats.h"
+#include "inc/galton_binomial.h"
+#include "inc/galton_telemetry.h"
+
+#define MAX_PINS (MAX_PIN_ROWS * (MAX_PIN_ROWS + 1) / 2) // Pinos da maior placa (disposição triangular)
+
+/* Parâmetros de uma placa */
+typedef struct {
+    float gravity;        // Aceleração por tick
+    float bounciness;     // Coeficiente de restituição
+    float balance_bias;   // Viés nos pinos (0 = sempre esquerda, 10 = sempre direita)
+    int balls_per_drop;   // Bolas por lançamento
+    int sim_mode;         // SIM_MODE_PHYSICS ou SIM_MODE_FAST_BINOMIAL
+    int sampler;          // SAMPLER_SCALAR, SAMPLER_SIMD ou SAMPLER_LANES (modo rápido)
+    int tick_ms;          // Tempo simulado por passo
+    // Geometria: só é aplicada em board_init e board_set_geometry
+    int pin_rows;         // Linhas de pinos (até MAX_PIN_ROWS)
+    int num_bins;         // Caixas coletoras (até MAX_BINS)
+    int pin_diameter;
+    int pin_spacing_h, pin_spacing_v;
+    int chute_width;
+    int bin_width;
+    int wall_offset;
+    int histogram_base_y;
+} galton_params_t;
+
+/* Estado completo de uma placa
+ * Pinos e bins ficam em vetores de tamanho fixo dentro da própria placa, dimensionados
+ * para a maior placa (MAX_PIN_ROWS, MAX_BINS): trocar o tamanho não aloca nada. */
+typedef struct {
+    galton_params_t params;
+
+    // Geometria derivada dos parâmetros
+    int wall_left, wall_right;   // Paredes laterais
+    int chute_left, chute_right; // Limites da canaleta de entrada
+    bool static_geometry;        // Igual à variante compilada: usa as tabelas de board_static
+    uint32_t geometry_version;   // Muda a cada board_set_geometry (a tela refaz a camada estática)
+    int num_pins;                // Pinos em uso em 'pins'
+    Pin pins[MAX_PINS];
+
+    // Coeficientes da física no tipo phys_t (ver board_update_params)
+    phys_t gravity_step;         // Gravidade somada a vy a cada tick
+    phys_coef_t bounce_coef;     // Elasticidade aplicada nos rebotes
+    phys_t pin_kick;             // Velocidade horizontal após bater num pino
+    uint32_t bias_threshold;     // Viés em ponto fixo de 32 bits (P = limiar / 2^32)
+    float bias_applied;          // Viés que gerou bias_threshold
+
+    // Estado da simulação
+    galton_rng_t rng;            // Fluxo próprio: decisões nos pinos e posição inicial
+    galton_rng_lanes_t lanes;    // 8 fluxos do sorteio bit a bit (disjuntos de rng)
+    ParticlePool particles;      // Partículas vivas (SoA compactado, memória do chamador)
+    galton_histogram_t hist;     // Contagens e estatísticas
+    uint64_t total_particles;    // Bolas lançadas
+    uint32_t sim_time_ms;        // Tempo simulado
+    uint32_t last_particle_time; // Tempo simulado do último lançamento
+    uint32_t steps;              // Passos executados (tick dos eventos de telemetria)
+    telemetry_ring_t *telemetry; // Pousos também vão para este anel (NULL: sem telemetria)
+} galton_board_t;
+
+extern galton_board_t main_board; // Placa da simulação exibida na tela
+
+void board_params_from_globals(galton_params_t *p); // Lê os parâmetros globais ajustáveis
+
+// Monta a placa: geometria, coeficientes, histogramas zerados e fluxo (seed, stream).
+// 'storage' guarda 4 * capacity valores (x, y, vx, vy) e pertence ao chamador.
+void board_init(galton_board_t *b, const galton_params_t *params, phys_t *storage, int capacity,
+                uint64_t seed, uint32_t stream);
+void init_main_board(uint64_t seed); // board_init de main_board com os parâmetros globais
+bool board_params_valid(const galton_params_t *p); // Geometria cabe nos vetores e na tela
+
+// Troca a geometria (linhas, bins, espaçamentos) sem alocar: refaz paredes e pinos e recomeça
+// a placa (sem partículas, histograma zerado, passos e tempo em 0); o gerador continua
+void board_set_geometry(galton_board_t *b, const galton_params_t *params);
+void board_reseed(galton_board_t *b, uint64_t seed, uint32_t stream); // Reinicia rng e lanes no fluxo (seed, stream)
+
+// Aplica gravidade, elasticidade, viés, bolas por lançamento, modo, sorteador e passo (não a geometria)
+void board_update_params(galton_board_t *b, const galton_params_t *params);
+
+int board_spawn_particle(galton_board_t *b);               // Índice da nova bola ou -1 se cheio
+void board_despawn_particle(galton_board_t *b, int index); // Mantém [0, count) compacto
+void board_check_pin_collisions(galton_board_t *b, int idx);
+void board_drop_fast_binomial(galton_board_t *b, int count); // Bolas direto no histograma
+void board_step(galton_board_t *b); // Um passo fixo: lançamentos, física, colisões e contagem
+
+// Passos seguintes que não mudariam nada além de steps e sim_time_ms (nenhuma bola viva, modo
+// física e o próximo lançamento ainda não venceu); 0 se o próximo passo já tem trabalho
+uint32_t board_idle_steps(const galton_board_t *b);
+void board_skip_steps(galton_board_t *b, uint32_t steps); // Equivale a 'steps' board_step ociosos
+
+#endif
@@ -0,0 +1,28 @@
+// Comandos de texto pelo terminal USB
+//
+// Uma linha por comando, terminada em '\n' ou '\r':
+//   board R B [H V W]  Reconfigura a placa da tela: R linhas de pinos, B caixas e, opcionais,
+//                      espaçamento horizontal/vertical dos pinos e largura das caixas (sem eles
+//                      valem os atuais). Responde "board=R,B,H,V,W" ou "board: ..." se não couber.
+//   p                  Resumo de tempos (galton_profile.h); vale sem Enter, como antes
+//
+// No firmware command_poll() lê a USB sem bloquear no laço do núcleo 0, o mesmo que roda
+// update_particles(), então a placa nunca muda no meio de um passo. No host galton_host
+// executa as mesmas linhas com --command.
+
+#ifndef GALTON_COMMAND_H
+#define GALTON_COMMAND_H
+
+#include <stdbool.h>
+
+#define COMMAND_MAX_LINE 48 // Maior linha aceita (o excesso é descartado)
+
+bool command_execute(const char *line); // Executa uma linha; false se desconhecida ou recusada
+
+#ifndef GALTON_HOST
+void command_poll(void); // Firmware: junta os caracteres recebidos e executa cada linha completa
+#else
+#define command_poll() ((void)0)
+#endif
+
+#endif
@@ -15,6 +15,8 @@
 #include "hardware/gpio.h" // Para controle dos GPIOs
 #include "hardware/pwm.h" // Para controle de PWM
 #include "inc/ssd1306.h" // Biblioteca específica do display OLED
+#include "inc/galton_rng.h" // Gerador pseudoaleatório com sementes explícitas
+#include "inc/galton_fixed.h" // Tipo numérico da física (float ou Q16.16)
 
 /* Configurações do display OLED */
 #define SDA_PIN 14      // Pino GPIO para dados I2C (SDA)
@@ -25,40 +27,80 @@
 #define SSD1306_BUFFER_SIZE (OLED_WIDTH * OLED_HEIGHT / 8) // Tamanho do buffer (1 bit por pixel)
 
 /* Controle de partículas */
-#define MAX_PARTICLES 15 // Número máximo de bolas na tela simultaneamente
+#ifndef MAX_PARTICLES
+#define MAX_PARTICLES 256 // Número máximo de bolas simultâneas (o build nativo usa dezenas de milhares)
+#endif
 #define PARTICLES_PER_SECOND 1 // Quantidade de bolas liberadas por segundo
 #define BALL_DIAMETER 1  // Diâmetro visual das bolas em pixels
 extern float GRAVITY;    // Aceleração gravitacional (será definido em .c)
 extern float BOUNCINESS; // Coeficiente de elasticidade (será definido em .c)
 
 /* Configuração dos pinos da placa de Galton */
-#define PIN_ROWS 5       // Número de linhas de pinos
+#ifndef PIN_ROWS
+#define PIN_ROWS 5       // Número de linhas de pinos no boot (variante compilada)
+#endif
+#ifndef MAX_PIN_ROWS
+#define MAX_PIN_ROWS 12  // Maior placa configurável em tempo de execução (define o tamanho dos vetores)
+#endif
+extern int PIN_ROW_COUNT; // Linhas de pinos atuais (reconfigure_board)
 extern int PIN_DIAMETER; // Diâmetro visual dos pinos
 extern int PIN_SPACING_HORIZONTAL; // Espaçamento horizontal entre pinos
 extern int PIN_SPACING_VERTICAL;   // Espaçamento vertical entre linhas
+#define PIN_TOP_Y 15     // Posição vertical da primeira linha de pinos
 
 /* Configuração das canaletas e receptáculos */
-#define NUM_BINS 6       // Número de caixas coletoras (deve ser ímpar para simetria)
+#ifndef NUM_BINS
+#define NUM_BINS 6       // Número de caixas coletoras no boot (variante compilada)
+#endif
+#ifndef MAX_BINS
+#define MAX_BINS 16      // Maior número de caixas configurável (a telemetria guarda o bin em 4 bits)
+#endif
+#if PIN_ROWS > MAX_PIN_ROWS || NUM_BINS > MAX_BINS
+#error "PIN_ROWS/NUM_BINS maiores que MAX_PIN_ROWS/MAX_BINS"
+#endif
+extern int BIN_COUNT;    // Caixas coletoras atuais (reconfigure_board)
 extern int CHUTE_WIDTH;  // Largura da canaleta inicial
 extern int BIN_WIDTH;    // Largura de cada caixa coletora
 extern int WALL_OFFSET;  // Distância das paredes laterais
 extern int MAX_HISTOGRAM_HEIGHT; // Altura máxima do histograma
 
 /* Controle de tempo e desempenho */
-extern int TICK_DELAY_MS; // Intervalo entre atualizações da simulação
+extern int TICK_DELAY_MS; // Passo fixo da simulação (ms de tempo simulado por update_particles)
+extern int TARGET_FPS;    // Quadros por segundo desejados no display
+#define MAX_STEPS_PER_FRAME 5 // Passos de física recuperados por quadro antes de descartar o atraso
+
+/* Modos de simulação */
+#define SIM_MODE_PHYSICS 0        // Cada bola é integrada tick a tick e colide com os pinos
+#define SIM_MODE_FAST_BINOMIAL 1  // Bin sorteado direto de uma decisão por linha; física só para a animação
+#ifndef SIM_MODE_DEFAULT
+#define SIM_MODE_DEFAULT SIM_MODE_PHYSICS
+#endif
+#define FAST_BALLS_PER_TICK 2000  // Bolas contabilizadas por tick no modo rápido (multiplicado por BALLS_PER_DROP)
+extern int SIM_MODE;              // Modo de simulação atual
+extern int BINOMIAL_SAMPLER;      // Sorteador do modo rápido (SAMPLER_*, ver galton_binomial.h)
+
+/* Divisão de tarefas entre os núcleos */
+#ifndef GALTON_DUAL_CORE
+#define GALTON_DUAL_CORE 1 // 1: simulação no núcleo 0, renderização e I2C no núcleo 1
+#endif
 
 /* Configuração dos botões de controle */
 #define BUTTON_A_PIN 5   // GPIO para botão A (controla número de bolas)
 #define BUTTON_B_PIN 6   // GPIO para botão B (controla desbalanceamento)
-#define DEBOUNCE_MS 200  // Tempo para evitar bouncing dos botões
+#define INPUT_DEBOUNCE_MS 20 // Bordas mais próximas que isso no mesmo botão são ricochete (descartadas na IRQ)
+#define LONG_PRESS_MS 800    // A ou B segurado por esse tempo é um toque longo (ver galton_input.h)
+#define CHORD_HOLD_MS 1000   // A e B segurados juntos por esse tempo trocam o tamanho da placa
 
-/* Estrutura para representar uma partícula/bola */
+/* Conjunto de partículas/bolas em estrutura de vetores (SoA)
+ * As bolas vivas ficam compactadas em [0, count): lançar acrescenta no fim e
+ * remover move a última para o lugar vago, ambos em O(1). Os vetores pertencem
+ * a quem monta a placa (ver board_init), então cada placa tem sua capacidade. */
 typedef struct {
-    float x, y;         // Posição atual (coordenadas)
-    float vx, vy;       // Velocidade nos eixos x e y
-    bool active;        // Indica se a partícula está ativa
-    int bin_position;   // Índice da caixa onde caiu (-1 se ainda em movimento)
-} Particle;
+    phys_t *x, *y;   // Posição atual (coordenadas)
+    phys_t *vx, *vy; // Velocidade nos eixos x e y
+    int count;       // Número de partículas vivas
+    int capacity;    // Tamanho dos vetores
+} ParticlePool;
 
 /* Estrutura para representar um pino da placa de Galton */
 typedef struct {
@@ -68,30 +110,26 @@ typedef struct {
 /* Variáveis globais */
 extern uint8_t oled_buffer[SSD1306_BUFFER_SIZE]; // Buffer para o display
 extern struct render_area oled_area; // Área de renderização do display
-extern Particle particles[MAX_PARTICLES]; // Array de partículas
-extern Pin pins[PIN_ROWS * (PIN_ROWS + 1) / 2]; // Array de pinos (disposição triangular)
-extern uint16_t histogram[NUM_BINS]; // Contagem de bolas por caixa
-extern uint32_t total_particles;    // Contador total de bolas lançadas
-extern absolute_time_t last_particle_time; // Último momento de liberação de bolas
-extern absolute_time_t last_button_time;   // Último pressionamento de botão
 extern float BALANCE_BIAS;         // Fator de desbalanceamento (0-10)
+extern uint64_t RNG_SEED;          // Semente da simulação (0 = usar o relógio no setup)
 extern int BALLS_PER_DROP;         // Bolas liberadas por ciclo (1-5)
-extern int WALL_LEFT, WALL_RIGHT;  // Posições das paredes laterais
 extern int HISTOGRAM_BASE_Y;       // Posição vertical base do histograma
-extern int CHUTE_LEFT, CHUTE_RIGHT; // Limites da canaleta inicial
+// Estado da simulação (partículas, pinos, paredes, histograma): main_board em galton_board.h
 
 /* Declarações de funções */
 void setup_display();    // Configura o display OLED
 void setup_buttons();    // Configura os botões
-void calculate_geometry(); // Calcula posições dos elementos
+void calculate_geometry(); // Calcula paredes e canaleta da placa da tela a partir dos parâmetros globais
 void initialize_pins();  // Posiciona os pinos na tela
-void init_particle(int index); // Inicializa uma partícula
+bool reconfigure_board(int rows, int bins, int spacing_h, int spacing_v, int bin_width); // Novo tamanho (false se não couber)
 void check_buttons();    // Verifica estado dos botões
-bool random_decision_with_bias(); // Decisão aleatória com viés
-void check_pin_collisions(int idx); // Verifica colisões com pinos
-void normalize_histogram(); // Ajusta o histograma para caber na tela
-void update_particles(); // Atualiza a simulação física
+void update_particles(); // Aplica os parâmetros globais e avança main_board um passo
+uint32_t idle_steps();   // Passos seguintes de update_particles() que não mudam nada (0 = há trabalho)
+void skip_idle_steps(uint32_t steps); // Avança esses passos de uma vez, sem simular
+void invalidate_static_layer(); // Pede para refazer a camada estática após mudar a geometria
 void render_oled();      // Renderiza tudo no display
+bool render_latest_snapshot(); // Desenha a fotografia mais recente da fila entre núcleos
+void render_core_main(); // Laço do núcleo 1 (renderização)
 void setup();           // Inicialização geral do sistema
 
 #endif // Fim do header guard
\ No newline at end of file
@@ -0,0 +1,62 @@
+// Tipo numérico da física: float ou ponto fixo Q16.16
+//
+// O RP2040 (Cortex-M0+) não tem FPU, então cada operação em float vira uma
+// chamada de software. Com GALTON_FIXED_POINT definido na compilação, posições
+// e velocidades passam a ser inteiros Q16.16 e a elasticidade Q16, de modo que o
+// laço por tick usa só somas, deslocamentos e multiplicações inteiras. Os
+// arredondamentos seguem os do float (produto ao mais próximo, conversão para
+// pixel truncando em direção ao zero), senão a distribuição das caixas se desloca.
+// Sem a definição, tudo continua em float.
+
+#ifndef GALTON_FIXED_H
+#define GALTON_FIXED_H
+
+#include <stdint.h>
+#include <stdbool.h>
+
+#ifdef GALTON_FIXED_POINT
+
+typedef int32_t phys_t;      // Posição/velocidade em Q16.16
+typedef int32_t phys_coef_t; // Coeficiente adimensional em Q16 (ex.: elasticidade)
+
+#define PHYS_FRAC_BITS 16
+#define PHYS_COEF_BITS 16
+
+#define PHYS_FROM_INT(i)        ((phys_t)(i) * (1 << PHYS_FRAC_BITS))
+#define PHYS_FROM_FLOAT(f)      ((phys_t)((f) * (float)(1 << PHYS_FRAC_BITS) + ((f) < 0 ? -0.5f : 0.5f)))
+#define PHYS_TO_INT(v)          ((int)((v) / (1 << PHYS_FRAC_BITS))) // Trunca em direção ao zero, como (int)float
+#define PHYS_TO_FLOAT(v)        ((float)(v) / (float)(1 << PHYS_FRAC_BITS))
+#define PHYS_COEF_FROM_FLOAT(f) ((phys_coef_t)((f) * (float)(1 << PHYS_COEF_BITS) + ((f) < 0 ? -0.5f : 0.5f)))
+
+// v * c arredondado ao mais próximo; o produto Q16.16 × Q16 precisa de 64 bits
+#define PHYS_SCALE(v, c) \
+    ((phys_t)(((int64_t)(v) * (c) + (1 << (PHYS_COEF_BITS - 1))) >> PHYS_COEF_BITS))
+
+// dx² + dy² < r² (r em pixels inteiros), calculado em Q8.8 para caber em 32 bits sem sinal;
+// a redução arredonda pelo módulo, senão o lado negativo (esquerda, acima) acertaria pinos mais longe
+static inline bool phys_dist2_lt(phys_t dx, phys_t dy, int r) {
+    int32_t ex = (dx < 0 ? -dx + 128 : dx + 128) >> 8, ey = (dy < 0 ? -dy + 128 : dy + 128) >> 8;
+    uint32_t r8 = (uint32_t)r << 8;
+    return (uint32_t)(ex * ex) + (uint32_t)(ey * ey) < r8 * r8;
+}
+
+#else
+
+typedef float phys_t;
+typedef float phys_coef_t;
+
+#define PHYS_FROM_INT(i)        ((float)(i))
+#define PHYS_FROM_FLOAT(f)      ((float)(f))
+#define PHYS_TO_INT(v)          ((int)(v))
+#define PHYS_TO_FLOAT(v)        (v)
+#define PHYS_COEF_FROM_FLOAT(f) ((float)(f))
+#define PHYS_SCALE(v, c)        ((v) * (c))
+
+// dx² + dy² < r²: mesmo resultado que sqrtf(dx² + dy²) < r, sem a raiz
+static inline bool phys_dist2_lt(phys_t dx, phys_t dy, int r) {
+    return dx * dx + dy * dy < (float)(r * r);
+}
+
+#endif
+
+#endif
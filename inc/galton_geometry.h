@@ -0,0 +1,75 @@
+// Geometria da placa padrão gerada em tempo de compilação
+//
+// A variante da placa (linhas, bins, espaçamentos, tamanho da tela) é descrita pelas
+// constantes BOARD_* abaixo, que também são os valores iniciais das variáveis ajustáveis
+// (PIN_DIAMETER, BIN_WIDTH, ...). src/galton_geometry.cpp instancia um template com essa
+// descrição e gera, por constexpr, as tabelas de board_static, que ficam na flash:
+// posição dos pinos, bin de cada coluna de pixels, linhas e colunas de pinos ao alcance
+// de cada pixel e a camada estática da tela (canaleta, paredes, divisórias e pinos).
+//
+// Uma placa cuja geometria é igual à da variante (galton_board_t.static_geometry) usa as
+// tabelas: o board_init copia os pinos em vez de calculá-los, a busca de colisões não
+// divide nada e a camada estática é copiada pronta. Outras geometrias (varreduras,
+// reconfiguração) seguem pelo caminho genérico, calculado em tempo de execução.
+
+#ifndef GALTON_GEOMETRY_H
+#define GALTON_GEOMETRY_H
+
+#include <stdint.h>
+#include "inc/galton_config.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* Variante compilada (pode ser trocada com -D, como PIN_ROWS e NUM_BINS) */
+#ifndef BOARD_PIN_DIAMETER
+#define BOARD_PIN_DIAMETER 3
+#endif
+#ifndef BOARD_PIN_SPACING_H
+#define BOARD_PIN_SPACING_H 9
+#endif
+#ifndef BOARD_PIN_SPACING_V
+#define BOARD_PIN_SPACING_V 7
+#endif
+#ifndef BOARD_CHUTE_WIDTH
+#define BOARD_CHUTE_WIDTH 0
+#endif
+#ifndef BOARD_BIN_WIDTH
+#define BOARD_BIN_WIDTH 9
+#endif
+#ifndef BOARD_WALL_OFFSET
+#define BOARD_WALL_OFFSET 0
+#endif
+#ifndef BOARD_MAX_HISTOGRAM_HEIGHT
+#define BOARD_MAX_HISTOGRAM_HEIGHT 13
+#endif
+#define BOARD_HISTOGRAM_BASE_Y (OLED_HEIGHT - 2)
+
+#define BOARD_NO_PIN 0xFF        // Faixa vazia em row_lo/col_lo
+#define BOARD_OUTSIDE_TABLES (-2) // board_static_pin_hit(): posição fora da tela, usar a busca genérica
+
+/* Tabelas da variante compilada (constantes, na flash) */
+typedef struct {
+    int wall_left, wall_right;                 // Paredes laterais
+    int chute_left, chute_right;               // Canaleta de entrada
+    Pin pins[PIN_ROWS * (PIN_ROWS + 1) / 2];   // Mesma ordem de board_init (linha a linha)
+    uint8_t bin_of_x[OLED_WIDTH];              // Bin de pouso de cada coluna de pixels
+    uint8_t row_lo[OLED_HEIGHT];               // Linhas de pinos ao alcance de cada y (BOARD_NO_PIN: nenhuma)
+    uint8_t row_hi[OLED_HEIGHT];
+    uint8_t col_lo[PIN_ROWS][OLED_WIDTH];      // Pinos da linha ao alcance de cada x (BOARD_NO_PIN: nenhum)
+    uint8_t col_hi[PIN_ROWS][OLED_WIDTH];
+    uint8_t layer[SSD1306_BUFFER_SIZE];        // Camada estática da tela, no formato do SSD1306
+} board_static_tables_t;
+
+extern const board_static_tables_t board_static;
+
+// Índice do pino atingido por uma bola em (x, y) na variante compilada, -1 se nenhum ou
+// BOARD_OUTSIDE_TABLES se (x, y) está fora da tela (as tabelas só cobrem a tela)
+int board_static_pin_hit(phys_t x, phys_t y);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
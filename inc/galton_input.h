@@ -0,0 +1,66 @@
+// Botões por interrupção: fila de bordas e reconhecimento de gestos
+//
+// As bordas de BUTTON_A_PIN e BUTTON_B_PIN geram uma IRQ de GPIO. O tratador lê
+// time_us_32(), descarta os ricochetes (bordas a menos de INPUT_DEBOUNCE_MS da última
+// aceita no mesmo botão) e enfileira o evento numa fila sem travas de um produtor (a IRQ)
+// e um consumidor (check_buttons, no laço da simulação). Um toque mais curto que um tick
+// não se perde: as duas bordas ficam na fila com os tempos em que aconteceram.
+//
+// check_buttons() só entra aqui quando input_pending(): há evento na fila ou um botão
+// segurado (o tempo do toque longo corre). Sem botões, o custo por tick é essa conferência.
+//
+// Gestos, resolvidos pelos tempos da IRQ (não pelo momento em que a fila é lida):
+//   toque em A ou B            INPUT_TAP_A / INPUT_TAP_B, ao soltar
+//   A ou B por LONG_PRESS_MS   INPUT_LONG_A / INPUT_LONG_B, ainda segurado
+//   A e B juntos, toque        INPUT_TAP_A | INPUT_TAP_B, ao soltar os dois
+//   A e B por CHORD_HOLD_MS    INPUT_CHORD_HOLD, ainda segurados
+// Depois de um gesto longo o resto é ignorado até soltar todos os botões.
+
+#ifndef GALTON_INPUT_H
+#define GALTON_INPUT_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stdatomic.h>
+
+#define INPUT_QUEUE_SIZE 32 // Eventos pendentes (potência de 2)
+
+/* Gestos (máscara; os quatro primeiros são gravados em galton_replay.h) */
+#define INPUT_TAP_A      0x01
+#define INPUT_TAP_B      0x02
+#define INPUT_LONG_A     0x04
+#define INPUT_LONG_B     0x08
+#define INPUT_CHORD_HOLD 0x10
+
+/* Borda aceita de um botão */
+typedef struct {
+    uint32_t time_us; // time_us_32() na IRQ
+    uint8_t button;   // 0 = A, 1 = B
+    bool pressed;     // true: desceu (pull-up, apertado lê nível baixo)
+} input_event_t;
+
+/* Fila sem travas: a IRQ só escreve head, o consumidor só escreve tail */
+typedef struct {
+    input_event_t events[INPUT_QUEUE_SIZE];
+    atomic_uint head;  // Próxima posição a escrever
+    atomic_uint tail;  // Próxima posição a ler
+    uint32_t dropped;  // Bordas perdidas com a fila cheia
+} input_queue_t;
+
+extern input_queue_t input_queue;
+
+void input_init(void); // Habilita as IRQs de borda dos botões (depois de configurar os pinos)
+
+bool input_queue_push(input_queue_t *q, const input_event_t *e); // Produtor (IRQ)
+const input_event_t *input_queue_peek(input_queue_t *q);          // Consumidor: evento mais antigo ou NULL
+void input_queue_pop(input_queue_t *q);                           // Consumidor: descarta o mais antigo
+
+static inline bool input_queue_empty(input_queue_t *q) {
+    return atomic_load_explicit(&q->head, memory_order_acquire) ==
+           atomic_load_explicit(&q->tail, memory_order_relaxed);
+}
+
+bool input_pending(void);                // Há eventos na fila ou um gesto em andamento
+int input_next_gesture(uint32_t now_us); // Próximo gesto concluído até now_us (INPUT_*), ou 0
+
+#endif
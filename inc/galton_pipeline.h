@@ -0,0 +1,86 @@
+// Pipeline de dois núcleos: simulação (núcleo 0) -> renderização (núcleo 1)
+//
+// A simulação publica "fotografias" do estado (bolas, histograma e contadores) numa
+// fila circular de produtor único / consumidor único, sem travas. A simulação nunca
+// espera pela tela: se a fila estiver cheia a fotografia é descartada, e a
+// renderização sempre desenha a mais recente que encontrar.
+
+#ifndef GALTON_PIPELINE_H
+#define GALTON_PIPELINE_H
+
+#include <stdint.h>
+#include <stdatomic.h>
+#include "inc/galton_config.h"
+#include "inc/galton_board.h"
+
+#ifndef SNAPSHOT_MAX_BALLS
+#define SNAPSHOT_MAX_BALLS 256  // Bolas desenhadas por quadro (as demais só são simuladas)
+#endif
+#define SNAPSHOT_QUEUE_SLOTS 4  // Fotografias em trânsito entre os núcleos
+
+/* Geometria da placa como a tela a desenha (camada estática e posição das barras)
+ * Copiada da placa só quando geometry_version muda: o outro núcleo nunca lê main_board,
+ * que a simulação reescreve ao trocar o tamanho (reconfigure_board). */
+typedef struct {
+    uint32_t version;                       // geometry_version da placa copiada
+    bool valid;                             // Já copiada nesta posição da fila
+    bool static_geometry;                   // Igual à variante compilada (camada pronta na flash)
+    int wall_left, wall_right;              // Paredes laterais
+    int chute_left, chute_right;            // Canaleta de entrada
+    int num_bins;                           // Barras do histograma
+    int bins_left;                          // x da primeira divisória
+    int bin_width;
+    int histogram_base_y;
+    int pin_radius;
+    int num_pins;
+    uint8_t pin_x[MAX_PINS], pin_y[MAX_PINS]; // Centros dos pinos em pixels
+} galton_layout_t;
+
+/* Estado necessário para desenhar um quadro */
+typedef struct {
+    uint32_t sequence;                      // Número do tick que gerou a fotografia
+    int ball_count;                         // Bolas em ball_x/ball_y
+    uint8_t ball_x[SNAPSHOT_MAX_BALLS];     // Posição das bolas em pixels
+    uint8_t ball_y[SNAPSHOT_MAX_BALLS];
+    uint64_t histogram[MAX_BINS];           // Contagens reais do histograma
+    uint64_t histogram_max;                 // Maior contagem (escala das barras)
+    galton_layout_t layout;                 // Geometria desta fotografia (a placa pode mudar de tamanho)
+    uint64_t total_particles;               // Total de bolas lançadas
+    int balls_per_drop;                     // Valor exibido em "A:"
+    int balance_bias;                       // Valor exibido em "B:" (viés arredondado)
+} galton_snapshot_t;
+
+/* Fila SPSC de fotografias: head só é escrito pelo produtor e tail só pelo consumidor */
+typedef struct {
+    galton_snapshot_t slots[SNAPSHOT_QUEUE_SLOTS];
+    atomic_uint head;               // Próxima posição a publicar
+    atomic_uint tail;               // Próxima posição a consumir
+    uint32_t dropped;               // Fotografias descartadas por fila cheia (contado pelo produtor)
+    uint32_t consumed;              // Fotografias desenhadas (contado pelo consumidor)
+    uint32_t out_of_order;          // Fotografias recebidas fora de ordem (deve ser sempre 0)
+    uint32_t last_sequence;         // Sequência da última fotografia desenhada
+    uint32_t geometry_regressions;  // Fotografias com geometria mais antiga que a anterior (deve ser sempre 0)
+    uint32_t geometry_changes;      // Fotografias com geometria mais nova que a anterior (trocas vistas pela tela)
+    uint32_t last_geometry_version; // Versão da geometria da última fotografia desenhada
+} snapshot_queue_t;
+
+extern snapshot_queue_t snapshot_queue; // Fila entre a simulação e a renderização
+
+void snapshot_capture(galton_snapshot_t *snap, uint32_t sequence); // Copia o estado atual da simulação
+
+// Produtor: reserva a próxima posição (NULL se cheia) e depois a publica
+galton_snapshot_t *snapshot_queue_begin_write(snapshot_queue_t *q);
+void snapshot_queue_publish(snapshot_queue_t *q);
+bool snapshot_queue_push_current(snapshot_queue_t *q, uint32_t sequence); // Captura e publica
+
+// Consumidor: obtém a fotografia mais recente (descartando as antigas) e depois a libera
+const galton_snapshot_t *snapshot_queue_acquire_latest(snapshot_queue_t *q);
+void snapshot_queue_release(snapshot_queue_t *q);
+
+// Produtor: o consumidor já liberou tudo o que foi publicado
+static inline bool snapshot_queue_drained(snapshot_queue_t *q) {
+    return atomic_load_explicit(&q->tail, memory_order_acquire) ==
+           atomic_load_explicit(&q->head, memory_order_relaxed);
+}
+
+#endif
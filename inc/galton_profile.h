@@ -0,0 +1,87 @@
+// Medição de tempo dos caminhos quentes (simulação, colisões, desenho e envio)
+//
+// Cada fase guarda suas últimas PROFILE_RING_SIZE amostras num anel estático (sem heap).
+// profile_print_summary() mostra mín/média/p99 por fase na saída padrão (USB CDC no
+// firmware). Com GALTON_PROFILE=0 (padrão) as macros somem e nada é medido.
+//
+// No firmware o relógio é o SysTick (ciclos de CPU, 24 bits), então intervalos menores
+// que 1 µs ainda aparecem; no host é o relógio monotônico em ns. Cada núcleo do RP2040
+// tem o seu SysTick: o núcleo que mede chama profile_init_core() antes da primeira medida
+// (profile_init() já configura o núcleo que a chama).
+
+#ifndef GALTON_PROFILE_H
+#define GALTON_PROFILE_H
+
+#include <stdint.h>
+#include <stdio.h>
+
+#ifndef GALTON_PROFILE
+#define GALTON_PROFILE 0
+#endif
+
+#ifndef PROFILE_RING_SIZE
+#define PROFILE_RING_SIZE 256   // Amostras guardadas por fase (potência de 2)
+#endif
+#define PROFILE_REPORT_MS 5000  // Intervalo do resumo periódico no firmware
+
+/* Fases medidas */
+typedef enum {
+    PROF_UPDATE = 0,   // update_particles() inteiro
+    PROF_COLLISIONS,   // Soma de board_check_pin_collisions() num tick
+    PROF_RENDER,       // Composição do quadro no buffer
+    PROF_DISPLAY,      // Envio ao display (render_dirty_on_display_dma)
+    PROF_NUM_PHASES
+} profile_phase_t;
+
+/* Anel de amostras de uma fase: cada fase é escrita por um único núcleo */
+typedef struct {
+    uint32_t samples[PROFILE_RING_SIZE]; // Duração em unidades de profile_now()
+    uint32_t count;                      // Total de amostras já gravadas
+} profile_ring_t;
+
+#if GALTON_PROFILE
+
+#ifdef GALTON_HOST
+uint32_t profile_now(void); // ns do relógio monotônico (truncado a 32 bits)
+#define PROFILE_TICKS_PER_US 1000u
+static inline uint32_t profile_elapsed(uint32_t start, uint32_t end) { return end - start; }
+#else
+#include "hardware/structs/systick.h"
+extern uint32_t profile_ticks_per_us; // Ciclos de CPU por µs (clk_sys)
+#define PROFILE_TICKS_PER_US profile_ticks_per_us
+// SysTick conta para baixo em 24 bits
+static inline uint32_t profile_now(void) { return systick_hw->cvr; }
+static inline uint32_t profile_elapsed(uint32_t start, uint32_t end) { return (start - end) & 0x00FFFFFFu; }
+#endif
+
+void profile_init(void);      // Zera os anéis e configura o SysTick do núcleo que chama
+void profile_init_core(void); // Só o SysTick do núcleo que chama (ex.: núcleo 1, que desenha)
+void profile_record(profile_phase_t phase, uint32_t ticks);
+void profile_print_summary(FILE *out);
+void profile_poll(void); // Firmware: resumo a cada PROFILE_REPORT_MS ou após profile_request_summary()
+void profile_request_summary(void); // Pede o resumo no próximo profile_poll() ('p' pela USB, galton_command.h)
+
+// Mede um trecho: PROFILE_START(t); ...; PROFILE_STOP(t, PROF_X);
+#define PROFILE_START(t)         uint32_t t = profile_now()
+#define PROFILE_STOP(t, phase)   profile_record(phase, profile_elapsed(t, profile_now()))
+// Acumula vários trechos curtos e grava uma amostra só: PROFILE_TOTAL(s); ... PROFILE_ADD(t, s); PROFILE_RECORD(PROF_X, s);
+#define PROFILE_TOTAL(s)         uint32_t s = 0
+#define PROFILE_ADD(t, s)        ((s) += profile_elapsed(t, profile_now()))
+#define PROFILE_RECORD(phase, s) profile_record(phase, s)
+
+#else
+
+#define profile_init()               ((void)0)
+#define profile_init_core()          ((void)0)
+#define profile_print_summary(out)   ((void)0)
+#define profile_poll()               ((void)0)
+#define profile_request_summary()    ((void)0)
+#define PROFILE_START(t)             ((void)0)
+#define PROFILE_STOP(t, phase)       ((void)0)
+#define PROFILE_TOTAL(s)             ((void)0)
+#define PROFILE_ADD(t, s)            ((void)0)
+#define PROFILE_RECORD(phase, s)     ((void)0)
+
+#endif
+
+#endif
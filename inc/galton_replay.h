@@ -0,0 +1,106 @@
+// Gravação e reprodução determinística de uma execução
+//
+// Tudo o que muda o rumo da simulação da placa da tela é a semente, os parâmetros
+// iniciais e os botões. A gravação guarda esses três num buffer compacto: um cabeçalho
+// com a semente e os parâmetros e, para cada tick com botão pressionado, o delta do tick
+// (varint) e os gestos dos botões (1 byte). Na reprodução check_buttons() lê os gestos da
+// gravação em vez da fila de galton_input.h, então partículas e histograma seguem exatamente
+// o mesmo caminho.
+//
+// Durante a gravação e a reprodução o estado da placa (partículas, histograma, gerador)
+// é acumulado tick a tick num hash FNV-1a; a reprodução confere o hash gravado no último
+// tick, o que permite comparar execuções bit a bit antes e depois de uma otimização.
+//
+// No firmware a gravação começa no boot com GALTON_REPLAY=1 e é impressa pela USB como
+// "replay=<hex>" a cada botão e a cada REPLAY_REPORT_MS; galton_host --replay aceita
+// essa linha ou o arquivo binário de galton_host --record.
+
+#ifndef GALTON_REPLAY_H
+#define GALTON_REPLAY_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include "inc/galton_board.h"
+#include "inc/galton_input.h"
+
+#ifndef GALTON_REPLAY
+#define GALTON_REPLAY 0
+#endif
+
+#ifndef REPLAY_MAX_EVENT_BYTES
+#define REPLAY_MAX_EVENT_BYTES 1024 // Eventos de botão gravados (até ~6 bytes cada)
+#endif
+#define REPLAY_REPORT_MS 10000       // Intervalo da impressão periódica no firmware
+#define REPLAY_HEADER_BYTES 60       // Cabeçalho serializado ("GRP2"; "GRP1", sem a geometria, tem 56)
+#define REPLAY_MAX_BYTES (REPLAY_HEADER_BYTES + REPLAY_MAX_EVENT_BYTES)
+
+/* Gestos de botão de um tick (máscara, os mesmos bits de galton_input.h) */
+#define REPLAY_BUTTON_A INPUT_TAP_A
+#define REPLAY_BUTTON_B INPUT_TAP_B
+#define REPLAY_BUTTON_LONG_A INPUT_LONG_A
+#define REPLAY_BUTTON_LONG_B INPUT_LONG_B
+
+typedef enum {
+    REPLAY_OFF = 0,
+    REPLAY_RECORDING,
+    REPLAY_PLAYING
+} replay_mode_t;
+
+/* Semente, parâmetros iniciais e resultado esperado */
+typedef struct {
+    uint64_t seed;
+    uint32_t ticks;          // Ticks cobertos pela gravação
+    uint64_t state_hash;     // Hash acumulado até o último tick
+    float balance_bias;      // Valores iniciais das variáveis ajustáveis
+    int32_t balls_per_drop;
+    int32_t sim_mode;
+    int32_t sampler;
+    int32_t tick_ms;
+    uint8_t pin_rows;        // Tamanho da placa gravada
+    uint8_t num_bins;
+    uint8_t fixed_point;     // Configuração de compilação (a reprodução precisa da mesma)
+    uint8_t truncated;       // Buffer de eventos encheu: botões depois disso foram perdidos
+    uint32_t capacity;       // MAX_PARTICLES da placa gravada
+    uint8_t pin_diameter;    // Geometria da placa gravada (GRP1: a da variante compilada)
+    uint8_t pin_spacing_h;
+    uint8_t pin_spacing_v;
+    uint8_t bin_width;
+} replay_header_t;
+
+typedef struct {
+    replay_mode_t mode;
+    replay_header_t header;
+    uint8_t events[REPLAY_MAX_EVENT_BYTES];
+    size_t length;           // Bytes usados em events
+    size_t cursor;           // Reprodução: próximo evento a ler
+    uint32_t last_tick;      // Tick do último evento gravado ou lido
+    uint32_t next_tick;      // Reprodução: tick do próximo evento
+    int next_buttons;        // Reprodução: botões do próximo evento (0 se acabou)
+    uint64_t hash;           // Hash acumulado até agora
+} galton_replay_t;
+
+extern galton_replay_t replay; // Gravação ou reprodução da placa da tela
+
+// Gravação: começa com a semente e os parâmetros globais atuais (recomeça a cada reconfigure_board)
+void replay_record_begin(galton_replay_t *r, uint64_t seed);
+void replay_record_buttons(galton_replay_t *r, uint32_t tick, int buttons);
+void replay_record_checkpoint(galton_replay_t *r, uint32_t ticks); // Ticks e hash até aqui (a gravação continua)
+
+size_t replay_serialize(const galton_replay_t *r, uint8_t *out, size_t capacity); // 0 se não couber
+bool replay_load(galton_replay_t *r, const uint8_t *data, size_t len);            // Entra em REPLAY_PLAYING
+const char *replay_incompatible(const galton_replay_t *r); // Motivo se a compilação atual não reproduz, ou NULL
+void replay_apply_header(const galton_replay_t *r);       // Semente e parâmetros iniciais nos globais
+
+int replay_buttons_at(galton_replay_t *r, uint32_t tick); // Reprodução: botões deste tick
+
+uint64_t replay_hash_board(const galton_board_t *b, uint64_t hash); // FNV-1a do estado da placa
+void replay_step(galton_replay_t *r, const galton_board_t *b);     // Acumula o hash após um tick
+
+#if GALTON_REPLAY && !defined(GALTON_HOST)
+void replay_poll(void); // Firmware: imprime a gravação a cada botão ou REPLAY_REPORT_MS
+#else
+#define replay_poll() ((void)0)
+#endif
+
+#endif
@@ -0,0 +1,62 @@
+// Gerador pseudoaleatório rápido e reprodutível (xoshiro128++)
+//
+// Substitui rand() nos caminhos quentes da simulação. Só usa somas, XOR,
+// deslocamentos e rotações de 32 bits, que são baratos no Cortex-M0+.
+// Cada fluxo (placa, thread) tem seu próprio estado, criado a partir de
+// uma semente explícita e de um número de fluxo.
+
+#ifndef GALTON_RNG_H
+#define GALTON_RNG_H
+
+#include <stdint.h>
+#include <stdbool.h>
+
+/* Estado de um fluxo do gerador */
+typedef struct {
+    uint32_t s[4];
+} galton_rng_t;
+
+/* Limiar de probabilidade em ponto fixo de 32 bits: P(verdadeiro) = limiar / 2^32 */
+#define RNG_THRESHOLD_HALF 0x80000000u // Probabilidade de 50%
+
+void rng_seed(galton_rng_t *rng, uint64_t seed, uint32_t stream); // Inicializa um fluxo
+void rng_jump(galton_rng_t *rng);  // Avança 2^64 passos (fluxos garantidamente disjuntos)
+uint32_t rng_threshold_from_probability(float p); // Converte probabilidade [0,1] para limiar
+
+// Preenche 'n' decisões em 'words' (bit i = decisão i) e retorna quantas foram verdadeiras
+int rng_fill_decisions(galton_rng_t *rng, uint32_t threshold, uint32_t *words, int n);
+
+// Conta quantas de 'n' decisões independentes foram verdadeiras (sem armazená-las)
+int rng_count_decisions(galton_rng_t *rng, uint32_t threshold, int n);
+
+static inline uint32_t rng_rotl(uint32_t x, int k) {
+    return (x << k) | (x >> (32 - k));
+}
+
+/* Próximo número de 32 bits do fluxo */
+static inline uint32_t rng_next(galton_rng_t *rng) {
+    uint32_t *s = rng->s;
+    uint32_t result = rng_rotl(s[0] + s[3], 7) + s[0];
+    uint32_t t = s[1] << 9;
+
+    s[2] ^= s[0];
+    s[3] ^= s[1];
+    s[1] ^= s[2];
+    s[0] ^= s[3];
+    s[2] ^= t;
+    s[3] = rng_rotl(s[3], 11);
+
+    return result;
+}
+
+/* Decisão com viés: verdadeiro com probabilidade threshold / 2^32 */
+static inline bool rng_decision(galton_rng_t *rng, uint32_t threshold) {
+    return rng_next(rng) < threshold;
+}
+
+/* Inteiro uniforme em [0, bound) por multiplicação (sem divisão nem módulo) */
+static inline uint32_t rng_below(galton_rng_t *rng, uint32_t bound) {
+    return (uint32_t)(((uint64_t)rng_next(rng) * bound) >> 32);
+}
+
+#endif
@@ -0,0 +1,50 @@
+// Escalonador de passo fixo: física em ritmo constante, tela na taxa que der
+//
+// Cada passo de física representa sempre TICK_DELAY_MS de tempo simulado. O
+// escalonador executa os passos atrasados (até MAX_STEPS_PER_FRAME por quadro),
+// desenha quando chega o prazo do quadro e dorme só até o próximo prazo. Se a
+// tela não acompanhar TARGET_FPS, quadros são pulados; a física não muda.
+//
+// Modo ocioso (scheduler_set_idle): quando o último passo já foi desenhado e os
+// próximos não mudam nada (sem bolas até o próximo lançamento), o escalonador dorme
+// direto até o passo que tem trabalho ou até um evento (botão), sem chamar o passo
+// nem o quadro, e depois avança os passos pulados de uma vez. Nada vai ao I2C.
+
+#ifndef GALTON_SCHEDULER_H
+#define GALTON_SCHEDULER_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "pico/stdlib.h"
+
+typedef void (*scheduler_fn)(void);
+typedef uint32_t (*scheduler_idle_fn)(void);     // Passos seguintes sem efeito (0 = o próximo tem trabalho)
+typedef void (*scheduler_skip_fn)(uint32_t steps); // Avança esses passos sem simular
+typedef bool (*scheduler_wake_fn)(void);          // Evento que encerra o sono antes do prazo
+
+/* Prazos e contadores do escalonador */
+typedef struct {
+    uint32_t step_us;           // Período de um passo de física
+    uint32_t frame_us;          // Período de um quadro (1 / TARGET_FPS)
+    absolute_time_t next_step;  // Prazo do próximo passo
+    absolute_time_t next_frame; // Prazo do próximo quadro
+    uint32_t steps;             // Passos de física executados
+    uint32_t frames;            // Quadros desenhados
+    uint32_t frames_skipped;    // Quadros pulados por falta de tempo
+    uint32_t steps_dropped;     // Passos abandonados quando o atraso passou de MAX_STEPS_PER_FRAME
+    uint32_t steps_idle;        // Passos pulados no modo ocioso (também contados em steps)
+    uint32_t idle_sleeps;       // Vezes em que dormiu no modo ocioso
+    bool pending;               // Há passos ainda não desenhados
+    scheduler_idle_fn idle;     // Modo ocioso (NULL: desligado)
+    scheduler_skip_fn skip;
+    scheduler_wake_fn wake;     // Pode ser NULL: dorme até o prazo
+} galton_scheduler_t;
+
+void scheduler_init(galton_scheduler_t *s, uint32_t step_ms, int target_fps); // Prazos a partir de agora
+void scheduler_set_idle(galton_scheduler_t *s, scheduler_idle_fn idle, scheduler_skip_fn skip, scheduler_wake_fn wake);
+
+// Uma iteração: passos atrasados, quadro se vencido e espera até o próximo prazo
+// Retorna true se desenhou um quadro
+bool scheduler_run_once(galton_scheduler_t *s, scheduler_fn step, scheduler_fn render);
+
+#endif
@@ -0,0 +1,50 @@
+// Histograma sem perdas e estatísticas incrementais da distribuição
+//
+// Os bins guardam contagens reais de 64 bits que nunca são reescritas; a altura
+// das barras é calculada só na hora de desenhar (histogram_bar_height). A cada bola
+// contada são atualizadas, em O(1), as somas de potências do índice do bin (média,
+// variância e assimetria) e a distância qui-quadrado à binomial ideal do viés atual.
+// Consultar as estatísticas também é O(1): nada percorre os bins.
+
+#ifndef GALTON_STATS_H
+#define GALTON_STATS_H
+
+#include <stdint.h>
+#include "inc/galton_config.h"
+
+/* Acumuladores da distribuição (k = índice do bin) */
+typedef struct {
+    uint64_t count;              // Bolas contadas (n)
+    uint64_t sum;                // Σ k
+    uint64_t sum_sq;             // Σ k²
+    uint64_t sum_cube;           // Σ k³ (exatos até ~10^15 bolas com k < 16)
+    double chi_acc;              // Σ (O_k - n·p_k)² / p_k
+    double expected[MAX_BINS];   // p_k da binomial ideal com o viés atual
+} galton_stats_t;
+
+/* Histograma de uma placa (vetores do tamanho da maior placa; usados só os num_bins primeiros) */
+typedef struct {
+    int rows;                // Linhas de pinos (parâmetro da binomial ideal)
+    int num_bins;            // Caixas em uso
+    uint64_t bins[MAX_BINS]; // Contagem real de bolas por caixa
+    uint64_t max;            // Maior contagem entre os bins (para a escala da tela)
+    galton_stats_t stats;    // Estatísticas das contagens
+} galton_histogram_t;
+
+void histogram_configure(galton_histogram_t *h, int rows, int num_bins); // Novo tamanho, já zerado
+void histogram_reset(galton_histogram_t *h);                      // Zera contagens e estatísticas
+void histogram_add(galton_histogram_t *h, int bin, uint64_t count); // Conta 'count' bolas no bin, em O(1)
+void histogram_set_reference(galton_histogram_t *h, uint32_t threshold); // Binomial ideal para o limiar (O(num_bins))
+
+double stats_mean(const galton_stats_t *s);
+double stats_variance(const galton_stats_t *s);  // Variância populacional
+double stats_skewness(const galton_stats_t *s);
+double stats_chi_square(const galton_stats_t *s); // Σ (O_k - E_k)² / E_k
+
+// Altura da barra na tela: contagem real até caber, depois proporcional ao maior bin
+static inline int histogram_bar_height(uint64_t count, uint64_t max_count, int max_height) {
+    if (max_count <= (uint64_t)max_height) return (int)count;
+    return (int)(count * (uint64_t)max_height / max_count);
+}
+
+#endif
@@ -0,0 +1,35 @@
+// Varredura de parâmetros: muitas placas independentes avançadas juntas
+//
+// Cada placa da varredura recebe o mesmo conjunto de parâmetros base, com um deles
+// (viés ou elasticidade) variando de 'from' a 'to'. As placas e as partículas ficam
+// em arenas estáticas; cada placa tem seu próprio fluxo aleatório (fluxo = índice + 1)
+// e seu histograma. sweep_run() avança as placas em blocos de SWEEP_CHUNK_TICKS passos
+// por placa, para que os vetores de uma placa fiquem no cache enquanto ela é simulada.
+
+#ifndef GALTON_SWEEP_H
+#define GALTON_SWEEP_H
+
+#include "inc/galton_board.h"
+
+#ifndef SWEEP_MAX_BOARDS
+#define SWEEP_MAX_BOARDS 128       // Placas numa varredura
+#endif
+#ifndef SWEEP_BOARD_PARTICLES
+#define SWEEP_BOARD_PARTICLES 1024 // Bolas simultâneas por placa
+#endif
+#define SWEEP_CHUNK_TICKS 64       // Passos seguidos de uma placa antes de passar à próxima
+
+/* Parâmetro variado entre as placas */
+typedef enum {
+    SWEEP_BIAS = 0,   // balance_bias
+    SWEEP_BOUNCINESS  // bounciness
+} sweep_param_t;
+
+// Monta as placas de from até to (inclusive) em passos de step; retorna quantas foram criadas
+int sweep_setup(const galton_params_t *base, sweep_param_t param, float from, float to, float step, uint64_t seed);
+void sweep_run(uint32_t ticks);        // Avança todas as placas 'ticks' passos
+int sweep_board_count(void);
+galton_board_t *sweep_board(int index);
+float sweep_value(int index);          // Valor do parâmetro variado na placa 'index'
+
+#endif
@@ -0,0 +1,97 @@
+// Telemetria binária dos pousos de bolas (USB CDC no firmware)
+//
+// board_step() grava cada pouso (tick, bin, viés, bolas por lançamento) num anel SPSC sem
+// travas; no modo rápido cada bin recebe um evento por tick com a contagem. O anel é
+// esvaziado em lotes, em quadros binários compactos, em vez de um printf por evento:
+//
+//   0xA5 0x5A | tamanho u16 | carga | CRC-16/CCITT u16 da carga   (inteiros little-endian)
+//   carga: versão u8 | sequência u16 | eventos perdidos (varint) | tick base (varint)
+//          | viés u8 (décimos) | bolas u8 | nº de eventos (varint) | eventos
+//   evento: byte de cabeçalho (bits 0-3 bin; bit 4 contagem != 1; bit 5 viés mudou;
+//           bit 6 bolas mudou; bit 7 tick mudou) seguido só dos campos sinalizados:
+//           contagem (varint), viés u8, bolas u8, delta do tick (varint)
+//
+// Cada quadro começa do tick base e do viés/bolas do cabeçalho, então o decodificador
+// pode entrar no meio do fluxo (ou pular texto de outros printf) e se ressincronizar pelo
+// par de sincronismo e pelo CRC. Pousos no mesmo tick e com os mesmos parâmetros custam 1 byte.
+//
+// No firmware a telemetria só é compilada com GALTON_TELEMETRY=1; no host galton_host
+// grava o mesmo fluxo com --telemetry e galton_decode o decodifica.
+
+#ifndef GALTON_TELEMETRY_H
+#define GALTON_TELEMETRY_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdatomic.h>
+
+#ifndef GALTON_TELEMETRY
+#define GALTON_TELEMETRY 0
+#endif
+
+#define TELEMETRY_RING_SIZE 1024   // Eventos em trânsito (potência de 2)
+#define TELEMETRY_FRAME_EVENTS 64  // Eventos por quadro (e lote mínimo para esvaziar antes do prazo)
+#define TELEMETRY_FLUSH_MS 100     // Prazo máximo de um evento no anel do firmware
+#define TELEMETRY_MAX_FRAME 1024   // Maior quadro possível, com folga
+#define TELEMETRY_SYNC0 0xA5
+#define TELEMETRY_SYNC1 0x5A
+#define TELEMETRY_VERSION 1
+
+/* Um pouso (ou, no modo rápido, 'count' pousos no mesmo bin e tick) */
+typedef struct {
+    uint32_t tick;           // Passo da placa (board_t.steps)
+    uint32_t count;          // Bolas
+    uint8_t bin;
+    uint8_t bias_x10;        // BALANCE_BIAS em décimos (0 a 100)
+    uint8_t balls_per_drop;
+} telemetry_event_t;
+
+/* Anel SPSC: head só é escrito pela simulação e tail só por quem envia */
+typedef struct {
+    telemetry_event_t events[TELEMETRY_RING_SIZE];
+    atomic_uint head;            // Próximo evento a gravar
+    atomic_uint tail;            // Próximo evento a enviar
+    atomic_uint dropped;         // Eventos perdidos com o anel cheio (contado pelo produtor)
+    uint32_t dropped_reported;   // Perdas já informadas nos quadros (consumidor)
+    uint16_t sequence;           // Número do próximo quadro (consumidor)
+} telemetry_ring_t;
+
+extern telemetry_ring_t telemetry_ring; // Anel da placa da tela
+
+void telemetry_reset(telemetry_ring_t *r);
+
+// Produtor: grava um evento (perdido e contado se o anel estiver cheio)
+void telemetry_emit(telemetry_ring_t *r, uint32_t tick, int bin, uint32_t count, float bias, int balls_per_drop);
+unsigned telemetry_pending(const telemetry_ring_t *r);
+
+// Consumidor: monta em 'out' um quadro com até TELEMETRY_FRAME_EVENTS eventos; 0 se não há o que enviar
+size_t telemetry_encode_frame(telemetry_ring_t *r, uint8_t *out);
+
+typedef void (*telemetry_write_fn)(const uint8_t *data, size_t len, void *ctx);
+void telemetry_flush(telemetry_ring_t *r, telemetry_write_fn write, void *ctx); // Envia quadros até esvaziar
+
+/* Decodificação incremental de um fluxo de bytes (host) */
+typedef struct {
+    uint8_t buf[TELEMETRY_MAX_FRAME];
+    size_t len;
+    uint64_t frames;         // Quadros válidos
+    uint64_t events;         // Eventos entregues
+    uint64_t bad_frames;     // CRC ou formato inválido
+    uint64_t skipped_bytes;  // Bytes fora de quadros (texto, ruído)
+    uint64_t events_lost;    // Soma dos eventos perdidos informados pelo firmware
+    uint64_t sequence_gaps;  // Quadros que faltaram entre dois recebidos
+    uint16_t last_sequence;
+} telemetry_parser_t;
+
+typedef void (*telemetry_event_fn)(const telemetry_event_t *ev, void *ctx);
+void telemetry_parser_init(telemetry_parser_t *p);
+void telemetry_parse(telemetry_parser_t *p, const uint8_t *data, size_t len, telemetry_event_fn on_event, void *ctx);
+
+#if GALTON_TELEMETRY && !defined(GALTON_HOST)
+void telemetry_poll(void); // Firmware: envia pela USB a cada TELEMETRY_FLUSH_MS ou ao juntar um quadro
+#else
+#define telemetry_poll() ((void)0)
+#endif
+
+#endif
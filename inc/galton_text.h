@@ -0,0 +1,38 @@
+// Campos de texto da tela com formatação inteira e glifos em cache
+//
+// Cada campo (ex.: "T:1234") guarda o último valor desenhado e as colunas dos seus
+// glifos já copiadas da fonte. text_field_set() só formata (sem printf, sem float) e
+// refaz o cache quando o valor muda; text_field_draw() copia as colunas para o quadro
+// em qualquer altura y (ssd1306_blit_columns divide cada coluna entre duas páginas).
+// Num quadro em que o valor não mudou, o campo custa uma comparação e a cópia das colunas.
+
+#ifndef GALTON_TEXT_H
+#define GALTON_TEXT_H
+
+#include <stdint.h>
+#include <stdbool.h>
+
+#define TEXT_FIELD_MAX_CHARS 16 // Rótulo + dígitos (16 caracteres de 8 px ocupam a tela inteira)
+#define TEXT_MAX_DIGITS 20      // Dígitos de um inteiro de 64 bits
+
+/* Campo de texto: rótulo fixo seguido de um número
+ * Declarado com inicializador, ex.: text_field_t f = {.x = 2, .y = 12, .prefix = "T:"}; */
+typedef struct {
+    int16_t x, y;           // Canto superior esquerdo, ou direito se right_aligned (y em qualquer pixel)
+    bool right_aligned;     // x é a borda direita (o campo cresce para a esquerda)
+    const char *prefix;     // Rótulo fixo (ex.: "T:")
+    bool valid;             // Cache preenchido
+    int64_t value;          // Valor que está no cache
+    uint8_t width;          // Colunas usadas em 'columns'
+    uint8_t columns[TEXT_FIELD_MAX_CHARS * 8]; // Glifos do texto, coluna a coluna (bit 0 no topo)
+    uint32_t renders;       // Vezes em que o texto foi refeito
+} text_field_t;
+
+// Decimal sem printf: escreve os dígitos (e o sinal) em 'out' com '\0' e retorna o comprimento
+int text_format_u64(char *out, uint64_t value);
+int text_format_i64(char *out, int64_t value);
+
+void text_field_set(text_field_t *f, int64_t value);             // Refaz o cache só se o valor mudou
+void text_field_draw(const text_field_t *f, uint8_t *buffer);    // Copia o cache para o quadro
+
+#endif
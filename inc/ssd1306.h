@@ -6,8 +6,21 @@ extern void ssd1306_send_buffer(uint8_t ssd[], int buffer_length);
 extern void ssd1306_init();
 extern void ssd1306_scroll(bool set);
 extern void render_on_display(uint8_t *ssd, struct render_area *area);
+extern void render_dirty_on_display(uint8_t *ssd);
+extern void ssd1306_invalidate();
+extern void ssd1306_dma_init();
+extern void ssd1306_dma_set_callback(void (*callback)(void));
+extern bool ssd1306_dma_busy();
+extern void ssd1306_dma_wait();
+extern void render_dirty_on_display_dma(uint8_t *ssd);
 extern void ssd1306_set_pixel(uint8_t *ssd, int x, int y, bool set);
 extern void ssd1306_draw_line(uint8_t *ssd, int x_0, int y_0, int x_1, int y_1, bool set);
+extern void ssd1306_fill_rect(uint8_t *ssd, int x, int y, int width, int height, bool set);
+extern void ssd1306_draw_vspan(uint8_t *ssd, int x, int y_0, int y_1, bool set);
+extern void ssd1306_draw_hspan(uint8_t *ssd, int x_0, int x_1, int y, bool set);
+extern void ssd1306_plot_points(uint8_t *ssd, const uint8_t *xs, const uint8_t *ys, int count);
+extern const uint8_t *ssd1306_glyph(uint8_t character);
+extern void ssd1306_blit_columns(uint8_t *ssd, int x, int y, const uint8_t *columns, int count);
 extern void ssd1306_draw_char(uint8_t *ssd, int16_t x, int16_t y, uint8_t character);
 extern void ssd1306_draw_string(uint8_t *ssd, int16_t x, int16_t y, char *string);
 extern void ssd1306_command(ssd1306_t *ssd, uint8_t command);
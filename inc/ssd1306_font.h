@@ -1,5 +1,5 @@
 
-static uint8_t font[] = {
+static const uint8_t font[] = { // Na flash: 8 colunas por caractere, bit 0 no topo
     0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, // Nothing
     0x78, 0x14, 0x12, 0x11, 0x12, 0x14, 0x78, 0x00, // A
     0x7f, 0x49, 0x49, 0x49, 0x49, 0x49, 0x7f, 0x00, // B
@@ -37,4 +37,63 @@ static uint8_t font[] = {
     0x01, 0x01, 0x01, 0x61, 0x31, 0x0d, 0x03, 0x00, // 7
     0x36, 0x49, 0x49, 0x49, 0x49, 0x49, 0x36, 0x00, // 8
     0x06, 0x09, 0x09, 0x09, 0x09, 0x09, 0x7f, 0x00, // 9
+    // Minúsculas e pontuação (5 colunas centradas na célula de 8)
+    0x00, 0x20, 0x54, 0x54, 0x54, 0x78, 0x00, 0x00, // a
+    0x00, 0x7f, 0x48, 0x44, 0x44, 0x38, 0x00, 0x00, // b
+    0x00, 0x38, 0x44, 0x44, 0x44, 0x20, 0x00, 0x00, // c
+    0x00, 0x38, 0x44, 0x44, 0x48, 0x7f, 0x00, 0x00, // d
+    0x00, 0x38, 0x54, 0x54, 0x54, 0x18, 0x00, 0x00, // e
+    0x00, 0x08, 0x7e, 0x09, 0x01, 0x02, 0x00, 0x00, // f
+    0x00, 0x0c, 0x52, 0x52, 0x52, 0x3e, 0x00, 0x00, // g
+    0x00, 0x7f, 0x08, 0x04, 0x04, 0x78, 0x00, 0x00, // h
+    0x00, 0x00, 0x44, 0x7d, 0x40, 0x00, 0x00, 0x00, // i
+    0x00, 0x20, 0x40, 0x44, 0x3d, 0x00, 0x00, 0x00, // j
+    0x00, 0x7f, 0x10, 0x28, 0x44, 0x00, 0x00, 0x00, // k
+    0x00, 0x00, 0x41, 0x7f, 0x40, 0x00, 0x00, 0x00, // l
+    0x00, 0x7c, 0x04, 0x18, 0x04, 0x78, 0x00, 0x00, // m
+    0x00, 0x7c, 0x08, 0x04, 0x04, 0x78, 0x00, 0x00, // n
+    0x00, 0x38, 0x44, 0x44, 0x44, 0x38, 0x00, 0x00, // o
+    0x00, 0x7c, 0x14, 0x14, 0x14, 0x08, 0x00, 0x00, // p
+    0x00, 0x08, 0x14, 0x14, 0x18, 0x7c, 0x00, 0x00, // q
+    0x00, 0x7c, 0x08, 0x04, 0x04, 0x08, 0x00, 0x00, // r
+    0x00, 0x48, 0x54, 0x54, 0x54, 0x20, 0x00, 0x00, // s
+    0x00, 0x04, 0x3f, 0x44, 0x40, 0x20, 0x00, 0x00, // t
+    0x00, 0x3c, 0x40, 0x40, 0x20, 0x7c, 0x00, 0x00, // u
+    0x00, 0x1c, 0x20, 0x40, 0x20, 0x1c, 0x00, 0x00, // v
+    0x00, 0x3c, 0x40, 0x30, 0x40, 0x3c, 0x00, 0x00, // w
+    0x00, 0x44, 0x28, 0x10, 0x28, 0x44, 0x00, 0x00, // x
+    0x00, 0x0c, 0x50, 0x50, 0x50, 0x3c, 0x00, 0x00, // y
+    0x00, 0x44, 0x64, 0x54, 0x4c, 0x44, 0x00, 0x00, // z
+    0x00, 0x00, 0x00, 0x5f, 0x00, 0x00, 0x00, 0x00, // !
+    0x00, 0x00, 0x07, 0x00, 0x07, 0x00, 0x00, 0x00, // "
+    0x00, 0x14, 0x7f, 0x14, 0x7f, 0x14, 0x00, 0x00, // #
+    0x00, 0x24, 0x2a, 0x7f, 0x2a, 0x12, 0x00, 0x00, // $
+    0x00, 0x23, 0x13, 0x08, 0x64, 0x62, 0x00, 0x00, // %
+    0x00, 0x36, 0x49, 0x56, 0x20, 0x50, 0x00, 0x00, // &
+    0x00, 0x00, 0x00, 0x07, 0x00, 0x00, 0x00, 0x00, // '
+    0x00, 0x00, 0x1c, 0x22, 0x41, 0x00, 0x00, 0x00, // (
+    0x00, 0x00, 0x41, 0x22, 0x1c, 0x00, 0x00, 0x00, // )
+    0x00, 0x2a, 0x1c, 0x7f, 0x1c, 0x2a, 0x00, 0x00, // *
+    0x00, 0x08, 0x08, 0x3e, 0x08, 0x08, 0x00, 0x00, // +
+    0x00, 0x00, 0x50, 0x30, 0x00, 0x00, 0x00, 0x00, // ,
+    0x00, 0x08, 0x08, 0x08, 0x08, 0x08, 0x00, 0x00, // -
+    0x00, 0x00, 0x60, 0x60, 0x00, 0x00, 0x00, 0x00, // .
+    0x00, 0x20, 0x10, 0x08, 0x04, 0x02, 0x00, 0x00, // /
+    0x00, 0x00, 0x36, 0x36, 0x00, 0x00, 0x00, 0x00, // :
+    0x00, 0x00, 0x56, 0x36, 0x00, 0x00, 0x00, 0x00, // ;
+    0x00, 0x08, 0x14, 0x22, 0x41, 0x00, 0x00, 0x00, // <
+    0x00, 0x14, 0x14, 0x14, 0x14, 0x14, 0x00, 0x00, // =
+    0x00, 0x00, 0x41, 0x22, 0x14, 0x08, 0x00, 0x00, // >
+    0x00, 0x02, 0x01, 0x51, 0x09, 0x06, 0x00, 0x00, // ?
+    0x00, 0x32, 0x49, 0x79, 0x41, 0x3e, 0x00, 0x00, // @
+    0x00, 0x00, 0x7f, 0x41, 0x41, 0x00, 0x00, 0x00, // [
+    0x00, 0x02, 0x04, 0x08, 0x10, 0x20, 0x00, 0x00, // \ (barra invertida)
+    0x00, 0x00, 0x41, 0x41, 0x7f, 0x00, 0x00, 0x00, // ]
+    0x00, 0x04, 0x02, 0x01, 0x02, 0x04, 0x00, 0x00, // ^
+    0x00, 0x40, 0x40, 0x40, 0x40, 0x40, 0x00, 0x00, // _
+    0x00, 0x00, 0x01, 0x02, 0x04, 0x00, 0x00, 0x00, // `
+    0x00, 0x00, 0x08, 0x36, 0x41, 0x00, 0x00, 0x00, // {
+    0x00, 0x00, 0x00, 0x7f, 0x00, 0x00, 0x00, 0x00, // |
+    0x00, 0x00, 0x41, 0x36, 0x08, 0x00, 0x00, 0x00, // }
+    0x00, 0x08, 0x04, 0x08, 0x10, 0x08, 0x00, 0x00, // ~
 };
\ No newline at end of file
@@ -1,10 +1,11 @@
 #include <stdio.h>
 #include <string.h>
 #include <stdlib.h>
-#include <ctype.h>
 #include "pico/stdlib.h"
 #include "pico/binary_info.h"
 #include "hardware/i2c.h"
+#include "hardware/dma.h"
+#include "hardware/irq.h"
 #include "ssd1306_font.h"
 #include "ssd1306_i2c.h"
 
@@ -13,9 +14,17 @@ void calculate_render_area_buffer_length(struct render_area *area) {
     area->buffer_length = (area->end_column - area->start_column + 1) * (area->end_page - area->start_page + 1);
 }
 
+// Buffer de transmissão estático com o byte de controle de dados (0x40) já na frente
+static uint8_t ssd1306_tx_buffer[1 + ssd1306_buffer_length] = {0x40};
+
+// Canal de DMA do display (-1 enquanto ssd1306_dma_init não for chamado)
+static int ssd1306_dma_channel = -1;
+void ssd1306_dma_wait();
+
 // Processo de escrita do i2c espera um byte de controle, seguido por dados
 void ssd1306_send_command(uint8_t command) {
     uint8_t buffer[2] = {0x80, command};
+    ssd1306_dma_wait(); // Não intercala com uma transferência por DMA em andamento
     i2c_write_blocking(i2c1, ssd1306_i2c_address, buffer, 2, false);
 }
 
@@ -26,16 +35,15 @@ void ssd1306_send_command_list(uint8_t *ssd, int number) {
     }
 }
 
-// Copia buffer de referência num novo buffer, a fim de adicionar o byte de controle desde o início
+// Copia o buffer de referência para o buffer de transmissão, logo após o byte de controle
+// (sem alocação; se os dados já estão no buffer de transmissão, não há cópia)
 void ssd1306_send_buffer(uint8_t ssd[], int buffer_length) {
-    uint8_t *temp_buffer = malloc(buffer_length + 1);
-
-    temp_buffer[0] = 0x40;
-    memcpy(temp_buffer + 1, ssd, buffer_length);
-
-    i2c_write_blocking(i2c1, ssd1306_i2c_address, temp_buffer, buffer_length + 1, false);
+    if (ssd != ssd1306_tx_buffer + 1) {
+        memcpy(ssd1306_tx_buffer + 1, ssd, buffer_length);
+    }
 
-    free(temp_buffer);
+    ssd1306_dma_wait();
+    i2c_write_blocking(i2c1, ssd1306_i2c_address, ssd1306_tx_buffer, buffer_length + 1, false);
 }
 
 // Cria a lista de comandos (com base nos endereços definidos em ssd1306_i2c.h) para a inicialização do display
@@ -85,6 +93,223 @@ void render_on_display(uint8_t *ssd, struct render_area *area) {
     ssd1306_send_buffer(ssd, area->buffer_length);
 }
 
+// Cópia do que já está (ou já está a caminho) na GDDRAM do display, usada para descobrir o que mudou
+static uint8_t ssd1306_shadow[ssd1306_buffer_length];
+static bool ssd1306_shadow_valid = false;
+
+// Janela retangular de colunas [c0, c1] nas páginas [p0, p1]
+typedef struct {
+    uint8_t c0, c1, p0, p1;
+} ssd1306_window_t;
+
+// Custo fixo (em bytes no barramento) de endereçar uma janela: 6 comandos e o byte de controle dos dados
+#define ssd1306_window_overhead (6 * 3 + 2)
+
+// Força o próximo render_dirty_on_display a enviar a tela inteira
+void ssd1306_invalidate() {
+    ssd1306_shadow_valid = false;
+}
+
+// Calcula as janelas alteradas desde a última transferência e atualiza a cópia local.
+// Páginas vizinhas são agrupadas numa janela só quando isso custa menos bytes no I2C.
+static int ssd1306_dirty_windows(const uint8_t *ssd, ssd1306_window_t windows[ssd1306_n_pages]) {
+    int first[ssd1306_n_pages], last[ssd1306_n_pages];
+    int count = 0;
+
+    if (!ssd1306_shadow_valid) {
+        memcpy(ssd1306_shadow, ssd, ssd1306_buffer_length);
+        ssd1306_shadow_valid = true;
+        windows[0] = (ssd1306_window_t){0, ssd1306_width - 1, 0, ssd1306_n_pages - 1};
+        return 1;
+    }
+
+    // Primeira e última coluna alteradas em cada página (-1 se a página não mudou)
+    for (int page = 0; page < ssd1306_n_pages; page++) {
+        const uint8_t *now = ssd + page * ssd1306_width;
+        const uint8_t *was = ssd1306_shadow + page * ssd1306_width;
+        int c0 = 0, c1 = ssd1306_width - 1;
+
+        while (c0 < ssd1306_width && now[c0] == was[c0]) c0++;
+        if (c0 == ssd1306_width) {
+            first[page] = last[page] = -1;
+            continue;
+        }
+        while (now[c1] == was[c1]) c1--;
+        first[page] = c0;
+        last[page] = c1;
+    }
+
+    int page = 0;
+    while (page < ssd1306_n_pages) {
+        if (first[page] < 0) {
+            page++;
+            continue;
+        }
+
+        // Começa uma janela nesta página e tenta estendê-la às páginas seguintes
+        int c0 = first[page], c1 = last[page], p0 = page, p1 = page;
+        int separate_cost = ssd1306_window_overhead + (c1 - c0 + 1);
+
+        while (p1 + 1 < ssd1306_n_pages && first[p1 + 1] >= 0) {
+            int n0 = first[p1 + 1] < c0 ? first[p1 + 1] : c0;
+            int n1 = last[p1 + 1] > c1 ? last[p1 + 1] : c1;
+            int merged_cost = ssd1306_window_overhead + (n1 - n0 + 1) * (p1 - p0 + 2);
+            int next_cost = separate_cost + ssd1306_window_overhead + (last[p1 + 1] - first[p1 + 1] + 1);
+
+            if (merged_cost > next_cost) break;
+            c0 = n0;
+            c1 = n1;
+            p1++;
+            separate_cost = merged_cost;
+        }
+
+        windows[count++] = (ssd1306_window_t){c0, c1, p0, p1};
+        for (int p = p0; p <= p1; p++) {
+            memcpy(ssd1306_shadow + p * ssd1306_width + c0, ssd + p * ssd1306_width + c0, c1 - c0 + 1);
+        }
+        page = p1 + 1;
+    }
+
+    return count;
+}
+
+// Atualiza o display enviando (de forma bloqueante) só as regiões alteradas desde a última transferência
+void render_dirty_on_display(uint8_t *ssd) {
+    ssd1306_window_t windows[ssd1306_n_pages];
+    int count = ssd1306_dirty_windows(ssd, windows);
+
+    for (int w = 0; w < count; w++) {
+        struct render_area area = {windows[w].c0, windows[w].c1, windows[w].p0, windows[w].p1};
+        int width = area.end_column - area.start_column + 1;
+
+        // Monta a janela contígua direto no buffer de transmissão
+        calculate_render_area_buffer_length(&area);
+        for (int page = area.start_page; page <= area.end_page; page++) {
+            memcpy(ssd1306_tx_buffer + 1 + (page - area.start_page) * width,
+                   ssd + page * ssd1306_width + area.start_column, width);
+        }
+        render_on_display(ssd1306_tx_buffer + 1, &area);
+    }
+}
+
+/************ Transferência por DMA com buffers duplos ************/
+// No RP2040 o DMA escreve no registrador IC_DATA_CMD em palavras de 16 bits: o byte
+// de dados fica nos bits 0-7 e o bit STOP encerra cada transação. Por isso cada buffer
+// de transferência já traz embutidos os comandos de endereçamento e o byte de controle
+// 0x40, e o quadro seguinte pode ser desenhado enquanto o anterior é enviado.
+#define ssd1306_dma_stream_max (ssd1306_n_pages * 8 + ssd1306_buffer_length)
+
+static uint16_t ssd1306_dma_streams[2][ssd1306_dma_stream_max];
+static int ssd1306_dma_back = 0;                 // Buffer livre para montar o próximo quadro
+static volatile bool ssd1306_dma_busy_flag = false; // DMA ainda alimentando o FIFO de TX do I2C
+static void (*ssd1306_dma_callback)(void) = NULL;
+
+static void ssd1306_dma_irq_handler(void) {
+    if (!dma_channel_get_irq0_status(ssd1306_dma_channel)) return;
+
+    dma_channel_acknowledge_irq0(ssd1306_dma_channel);
+    ssd1306_dma_busy_flag = false;
+    if (ssd1306_dma_callback) ssd1306_dma_callback();
+}
+
+// Reserva um canal de DMA ligado ao TX do I2C do display
+void ssd1306_dma_init() {
+    ssd1306_dma_channel = dma_claim_unused_channel(true);
+
+    dma_channel_config config = dma_channel_get_default_config(ssd1306_dma_channel);
+    channel_config_set_transfer_data_size(&config, DMA_SIZE_16);
+    channel_config_set_read_increment(&config, true);
+    channel_config_set_write_increment(&config, false);
+    channel_config_set_dreq(&config, i2c_get_dreq(i2c1, true));
+    dma_channel_configure(ssd1306_dma_channel, &config, &i2c_get_hw(i2c1)->data_cmd, NULL, 0, false);
+
+    // O DMA não passa pelo i2c_write_blocking, então o endereço do display é fixado aqui
+    i2c_get_hw(i2c1)->enable = 0;
+    i2c_get_hw(i2c1)->tar = ssd1306_i2c_address;
+    i2c_get_hw(i2c1)->enable = 1;
+
+    dma_channel_set_irq0_enabled(ssd1306_dma_channel, true);
+    irq_set_exclusive_handler(DMA_IRQ_0, ssd1306_dma_irq_handler);
+    irq_set_enabled(DMA_IRQ_0, true);
+}
+
+// Função chamada (no contexto da interrupção) ao fim de cada transferência por DMA
+// (o FIFO do I2C ainda pode estar esvaziando: ver ssd1306_dma_wait)
+void ssd1306_dma_set_callback(void (*callback)(void)) {
+    ssd1306_dma_callback = callback;
+}
+
+// O fim do DMA só diz que a última palavra entrou no FIFO de TX (até 16 entradas, com a do STOP);
+// o quadro termina quando o FIFO esvazia e o controlador para. Desabilitar IC_ENABLE antes disso
+// (i2c_write_blocking faz isso para reprogramar TAR) cortaria o fim do quadro.
+static bool ssd1306_i2c_idle() {
+    uint32_t status = i2c_get_hw(i2c1)->status;
+    return (status & I2C_IC_STATUS_TFE_BITS) && !(status & I2C_IC_STATUS_ACTIVITY_BITS);
+}
+
+bool ssd1306_dma_busy() {
+    return ssd1306_dma_busy_flag || !ssd1306_i2c_idle();
+}
+
+void ssd1306_dma_wait() {
+    while (ssd1306_dma_busy_flag) {
+        tight_loop_contents();
+    }
+    if (ssd1306_dma_channel < 0) return; // Sem DMA, i2c_write_blocking já espera o fim de cada envio
+    while (!ssd1306_i2c_idle()) {
+        tight_loop_contents(); // FIFO esvaziando: a transação com STOP ainda está no barramento
+    }
+}
+
+// Acrescenta uma transação I2C (byte de controle + bytes) ao buffer de transferência
+static int ssd1306_dma_append(uint16_t *stream, int n, uint8_t control, const uint8_t *bytes, int count) {
+    stream[n++] = control;
+    for (int i = 0; i < count; i++) {
+        stream[n++] = bytes[i];
+    }
+    stream[n - 1] |= I2C_IC_DATA_CMD_STOP_BITS; // Último byte encerra a transação
+    return n;
+}
+
+// Monta as regiões alteradas no buffer livre e inicia o envio por DMA, sem esperar o fim.
+// Sem canal de DMA (ssd1306_dma_init não chamado), cai no envio bloqueante.
+void render_dirty_on_display_dma(uint8_t *ssd) {
+    if (ssd1306_dma_channel < 0) {
+        render_dirty_on_display(ssd);
+        return;
+    }
+
+    ssd1306_window_t windows[ssd1306_n_pages];
+    int count = ssd1306_dirty_windows(ssd, windows);
+    if (count == 0) return;
+
+    uint16_t *stream = ssd1306_dma_streams[ssd1306_dma_back];
+    int n = 0;
+
+    for (int w = 0; w < count; w++) {
+        uint8_t commands[] = {
+            ssd1306_set_column_address, windows[w].c0, windows[w].c1,
+            ssd1306_set_page_address, windows[w].p0, windows[w].p1
+        };
+        n = ssd1306_dma_append(stream, n, 0x00, commands, count_of(commands)); // Co=0, D/C=0: comandos
+
+        stream[n++] = 0x40; // Co=0, D/C=1: dados
+        for (int page = windows[w].p0; page <= windows[w].p1; page++) {
+            const uint8_t *row = ssd + page * ssd1306_width;
+            for (int c = windows[w].c0; c <= windows[w].c1; c++) {
+                stream[n++] = row[c];
+            }
+        }
+        stream[n - 1] |= I2C_IC_DATA_CMD_STOP_BITS;
+    }
+
+    // Só o envio anterior precisa terminar; o desenho deste quadro já foi copiado
+    ssd1306_dma_wait();
+    ssd1306_dma_busy_flag = true;
+    dma_channel_transfer_from_buffer_now(ssd1306_dma_channel, stream, n);
+    ssd1306_dma_back ^= 1;
+}
+
 // Determina o pixel a ser aceso (no display) de acordo com a coordenada fornecida
 void ssd1306_set_pixel(uint8_t *ssd, int x, int y, bool set) {
     assert(x >= 0 && x < ssd1306_width && y >= 0 && y < ssd1306_height);
@@ -104,6 +329,54 @@ void ssd1306_set_pixel(uint8_t *ssd, int x, int y, bool set) {
     ssd[byte_idx] = byte;
 }
 
+// Preenche um retângulo página a página: cada byte recebe a máscara das linhas cobertas,
+// e páginas totalmente cobertas são preenchidas com memset (palavras inteiras). Recorta nas bordas.
+void ssd1306_fill_rect(uint8_t *ssd, int x, int y, int width, int height, bool set) {
+    int x0 = x < 0 ? 0 : x;
+    int y0 = y < 0 ? 0 : y;
+    int x1 = x + width - 1 >= ssd1306_width ? ssd1306_width - 1 : x + width - 1;
+    int y1 = y + height - 1 >= ssd1306_height ? ssd1306_height - 1 : y + height - 1;
+
+    if (x0 > x1 || y0 > y1) return;
+
+    int columns = x1 - x0 + 1;
+    for (int page = y0 >> 3; page <= y1 >> 3; page++) {
+        int top = page == (y0 >> 3) ? (y0 & 7) : 0;
+        int bottom = page == (y1 >> 3) ? (y1 & 7) : 7;
+        uint8_t mask = (uint8_t)((0xFF << top) & (0xFF >> (7 - bottom)));
+        uint8_t *row = ssd + page * ssd1306_width + x0;
+
+        if (mask == 0xFF) {
+            memset(row, set ? 0xFF : 0x00, columns);
+        } else if (set) {
+            for (int c = 0; c < columns; c++) row[c] |= mask;
+        } else {
+            for (int c = 0; c < columns; c++) row[c] &= (uint8_t)~mask;
+        }
+    }
+}
+
+// Linha vertical de y_0 até y_1 (inclusive), escrevendo bytes inteiros por página
+void ssd1306_draw_vspan(uint8_t *ssd, int x, int y_0, int y_1, bool set) {
+    if (y_0 > y_1) { int t = y_0; y_0 = y_1; y_1 = t; }
+    ssd1306_fill_rect(ssd, x, y_0, 1, y_1 - y_0 + 1, set);
+}
+
+// Linha horizontal de x_0 até x_1 (inclusive): uma máscara só para todas as colunas
+void ssd1306_draw_hspan(uint8_t *ssd, int x_0, int x_1, int y, bool set) {
+    if (x_0 > x_1) { int t = x_0; x_0 = x_1; x_1 = t; }
+    ssd1306_fill_rect(ssd, x_0, y, x_1 - x_0 + 1, 1, set);
+}
+
+// Acende vários pontos de uma vez, sem divisões nem asserts (pontos fora da tela são ignorados)
+void ssd1306_plot_points(uint8_t *ssd, const uint8_t *xs, const uint8_t *ys, int count) {
+    for (int i = 0; i < count; i++) {
+        unsigned x = xs[i], y = ys[i];
+        if (x >= ssd1306_width || y >= ssd1306_height) continue;
+        ssd[(y >> 3) * ssd1306_width + x] |= (uint8_t)(1u << (y & 7));
+    }
+}
+
 // Algoritmo de Bresenham básico
 void ssd1306_draw_line(uint8_t *ssd, int x_0, int y_0, int x_1, int y_1, bool set) {
     int dx = abs(x_1 - x_0); // Deslocamentos
@@ -132,8 +405,11 @@ void ssd1306_draw_line(uint8_t *ssd, int x_0, int y_0, int x_1, int y_1, bool se
     }
 }
 
+// Pontuação na ordem em que aparece em ssd1306_font.h, depois das minúsculas
+static const char ssd1306_font_punctuation[] = "!\"#$%&'()*+,-./:;<=>?@[\\]^_`{|}~";
+
 // Adquire os pixels para um caractere (de acordo com ssd1306_font.h)
-inline int ssd1306_get_font(uint8_t character)
+static inline int ssd1306_get_font(uint8_t character)
 {
   if (character >= 'A' && character <= 'Z') {
     return character - 'A' + 1;
@@ -141,25 +417,52 @@ inline int ssd1306_get_font(uint8_t character)
   else if (character >= '0' && character <= '9') {
     return character - '0' + 27;
   }
+  else if (character >= 'a' && character <= 'z') {
+    return character - 'a' + 37;
+  }
+  else if (character > ' ' && character < 0x7F) {
+    return (int)(strchr(ssd1306_font_punctuation, character) - ssd1306_font_punctuation) + 63;
+  }
   else
     return 0;
 }
 
-// Desenha um único caractere no display
-void ssd1306_draw_char(uint8_t *ssd, int16_t x, int16_t y, uint8_t character) {
-    if (x > ssd1306_width - 8 || y > ssd1306_height - 8) {
+// 8 colunas do caractere (bit 0 no topo); caracteres sem desenho dão o glifo vazio
+const uint8_t *ssd1306_glyph(uint8_t character) {
+    return &font[ssd1306_get_font(character) * 8];
+}
+
+// Escreve colunas de 8 px na altura y: com y fora da página, cada coluna é dividida entre
+// a página de y e a seguinte. A faixa y..y+7 é substituída (o fundo sob o texto é apagado).
+void ssd1306_blit_columns(uint8_t *ssd, int x, int y, const uint8_t *columns, int count) {
+    if (y < 0 || y > ssd1306_height - 8) return;
+    if (x < 0) { columns -= x; count += x; x = 0; }
+    if (x + count > ssd1306_width) count = ssd1306_width - x;
+
+    int shift = y & 7;
+    uint8_t *top = ssd + (y >> 3) * ssd1306_width + x;
+
+    if (shift == 0) { // Alinhado à página: cópia direta
+        memcpy(top, columns, count > 0 ? count : 0);
         return;
     }
 
-    y = y / 8;
-
-    character = toupper(character);
-    int idx = ssd1306_get_font(character);
-    int fb_idx = y * 128 + x;
+    uint8_t *bottom = top + ssd1306_width;
+    uint8_t keep_top = (uint8_t)(0xFF >> (8 - shift)); // Linhas acima de y na primeira página
+    uint8_t keep_bottom = (uint8_t)(0xFF << shift);    // Linhas abaixo de y+7 na segunda
+    for (int i = 0; i < count; i++) {
+        top[i] = (uint8_t)((top[i] & keep_top) | (columns[i] << shift));
+        bottom[i] = (uint8_t)((bottom[i] & keep_bottom) | (columns[i] >> (8 - shift)));
+    }
+}
 
-    for (int i = 0; i < 8; i++) {
-        ssd[fb_idx++] = font[idx * 8 + i];
+// Desenha um único caractere no display, em qualquer altura y
+void ssd1306_draw_char(uint8_t *ssd, int16_t x, int16_t y, uint8_t character) {
+    if (x > ssd1306_width - 8 || y > ssd1306_height - 8) {
+        return;
     }
+
+    ssd1306_blit_columns(ssd, x, y, ssd1306_glyph(character), 8);
 }
 
 // Desenha uma string, chamando a função de desenhar caractere várias vezes
@@ -177,6 +480,7 @@ void ssd1306_draw_string(uint8_t *ssd, int16_t x, int16_t y, char *string) {
 // Comando de configuração com base na estrutura ssd1306_t
 void ssd1306_command(ssd1306_t *ssd, uint8_t command) {
   ssd->port_buffer[1] = command;
+  ssd1306_dma_wait();
   i2c_write_blocking(
 	ssd->i2c_port, ssd->address, ssd->port_buffer, 2, false );
 }
@@ -0,0 +1,225 @@
+// Sorteio binomial bit a bit: versão portátil e kernel AVX2
+
+#include <string.h>
+#include "inc/galton_binomial.h"
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <immintrin.h>
+#define BINOMIAL_HAVE_AVX2 1
+#else
+#define BINOMIAL_HAVE_AVX2 0
+#endif
+
+#define BINOMIAL_BLOCK_BALLS (RNG_LANES * 4) // Uma bola por byte de cada palavra
+
+/************ Semeadura ************/
+void rng_lanes_seed(galton_rng_lanes_t *r, uint64_t seed, uint32_t stream) {
+    galton_rng_t lane;
+    rng_seed(&lane, seed, stream);
+
+    // Cada fluxo começa 2^64 passos depois do anterior (e o primeiro, depois do gerador escalar)
+    for (int i = 0; i < RNG_LANES; i++) {
+        rng_jump(&lane);
+        for (int k = 0; k < 4; k++) r->s[k][i] = lane.s[k];
+    }
+}
+
+/************ Versão portátil ************/
+static inline void lanes_next(galton_rng_lanes_t *r, uint32_t out[RNG_LANES]) {
+    for (int i = 0; i < RNG_LANES; i++) {
+        uint32_t s0 = r->s[0][i], s1 = r->s[1][i], s2 = r->s[2][i], s3 = r->s[3][i];
+        uint32_t t = s1 << 9;
+
+        out[i] = rng_rotl(s0 + s3, 7) + s0;
+        s2 ^= s0;
+        s3 ^= s1;
+        s1 ^= s2;
+        s0 ^= s3;
+        s2 ^= t;
+        s3 = rng_rotl(s3, 11);
+
+        r->s[0][i] = s0; r->s[1][i] = s1; r->s[2][i] = s2; r->s[3][i] = s3;
+    }
+}
+
+// Uma rodada de 256 decisões restritas aos bits de 'mask'; bits fora da máscara ficam em 0
+static void lanes_decide(galton_rng_lanes_t *r, uint32_t threshold, int low_bit,
+                         const uint32_t mask[RNG_LANES], uint32_t dec[RNG_LANES]) {
+    uint32_t und[RNG_LANES]; // Decisões ainda empatadas com o prefixo do limiar
+    uint32_t rnd[RNG_LANES];
+
+    for (int i = 0; i < RNG_LANES; i++) {
+        und[i] = mask[i];
+        dec[i] = 0;
+    }
+
+    for (int j = 31; j >= low_bit; j--) {
+        uint32_t pending = 0;
+        lanes_next(r, rnd);
+
+        if ((threshold >> j) & 1) { // Bit 0 no aleatório: menor que o limiar
+            for (int i = 0; i < RNG_LANES; i++) {
+                dec[i] |= und[i] & ~rnd[i];
+                und[i] &= rnd[i];
+                pending |= und[i];
+            }
+        } else {                    // Bit 1 no aleatório: maior que o limiar
+            for (int i = 0; i < RNG_LANES; i++) {
+                und[i] &= ~rnd[i];
+                pending |= und[i];
+            }
+        }
+        if (!pending) break;
+    }
+    // Empates até o último bit 1 do limiar continuam iguais ou maiores: decisão falsa
+}
+
+static void binomial_count_portable(galton_rng_lanes_t *r, uint32_t threshold, int rows, uint64_t blocks,
+                                    const uint32_t *last_mask, uint64_t *counts) {
+    uint32_t field = 0x01010101u * ((1u << rows) - 1); // Bits de decisão de cada byte
+    uint32_t full[RNG_LANES], dec[RNG_LANES];
+    int low_bit = __builtin_ctz(threshold);
+
+    for (int i = 0; i < RNG_LANES; i++) full[i] = field;
+
+    for (uint64_t b = 0; b < blocks + (last_mask != NULL); b++) {
+        lanes_decide(r, threshold, low_bit, b < blocks ? full : last_mask, dec);
+        for (int i = 0; i < RNG_LANES; i++) {
+            for (int byte = 0; byte < 4; byte++) counts[__builtin_popcount((dec[i] >> (8 * byte)) & 0xFF)]++;
+        }
+    }
+}
+
+/************ Kernel AVX2 ************/
+#if BINOMIAL_HAVE_AVX2
+
+#define AVX2_ROTL(x, k) _mm256_or_si256(_mm256_slli_epi32((x), (k)), _mm256_srli_epi32((x), 32 - (k)))
+
+// Soma os contadores de 8 bits de cada bin (até 255 rodadas) nos totais de 64 bits
+__attribute__((target("avx2")))
+static void avx2_flush(__m256i *acc, int rows, uint64_t *counts) {
+    for (int k = 0; k <= rows; k++) {
+        __m256i sums = _mm256_sad_epu8(acc[k], _mm256_setzero_si256()); // 4 somas de 8 bytes
+        uint64_t lane[4];
+        _mm256_storeu_si256((__m256i *)lane, sums);
+        counts[k] += lane[0] + lane[1] + lane[2] + lane[3];
+        acc[k] = _mm256_setzero_si256();
+    }
+}
+
+__attribute__((target("avx2")))
+static void binomial_count_avx2(galton_rng_lanes_t *r, uint32_t threshold, int rows, uint64_t blocks,
+                                const uint32_t *last_mask, uint64_t *counts) {
+    __m256i s0 = _mm256_loadu_si256((const __m256i *)r->s[0]);
+    __m256i s1 = _mm256_loadu_si256((const __m256i *)r->s[1]);
+    __m256i s2 = _mm256_loadu_si256((const __m256i *)r->s[2]);
+    __m256i s3 = _mm256_loadu_si256((const __m256i *)r->s[3]);
+
+    const __m256i field = _mm256_set1_epi8((char)((1u << rows) - 1));
+    const __m256i nibble = _mm256_set1_epi8(0x0F);
+    const __m256i popcnt_lut = _mm256_setr_epi8(0, 1, 1, 2, 1, 2, 2, 3, 1, 2, 2, 3, 2, 3, 3, 4,
+                                                0, 1, 1, 2, 1, 2, 2, 3, 1, 2, 2, 3, 2, 3, 3, 4);
+    __m256i acc[BINOMIAL_MAX_ROWS + 1]; // Contadores de 8 bits por byte, um vetor por bin
+    int low_bit = __builtin_ctz(threshold);
+    int pending_rounds = 0;
+
+    for (int k = 0; k <= rows; k++) acc[k] = _mm256_setzero_si256();
+
+    for (uint64_t b = 0; b < blocks + (last_mask != NULL); b++) {
+        __m256i und = b < blocks ? field : _mm256_loadu_si256((const __m256i *)last_mask);
+        __m256i dec = _mm256_setzero_si256();
+
+        for (int j = 31; j >= low_bit; j--) {
+            // xoshiro128++ nos 8 fluxos
+            __m256i rnd = _mm256_add_epi32(AVX2_ROTL(_mm256_add_epi32(s0, s3), 7), s0);
+            __m256i t = _mm256_slli_epi32(s1, 9);
+            s2 = _mm256_xor_si256(s2, s0);
+            s3 = _mm256_xor_si256(s3, s1);
+            s1 = _mm256_xor_si256(s1, s2);
+            s0 = _mm256_xor_si256(s0, s3);
+            s2 = _mm256_xor_si256(s2, t);
+            s3 = AVX2_ROTL(s3, 11);
+
+            if ((threshold >> j) & 1) {
+                dec = _mm256_or_si256(dec, _mm256_andnot_si256(rnd, und));
+                und = _mm256_and_si256(und, rnd);
+            } else {
+                und = _mm256_andnot_si256(rnd, und);
+            }
+            if (_mm256_testz_si256(und, und)) break;
+        }
+
+        // Popcount de cada byte por tabela de nibbles, depois um contador por bin
+        __m256i pc = _mm256_add_epi8(_mm256_shuffle_epi8(popcnt_lut, _mm256_and_si256(dec, nibble)),
+                                     _mm256_shuffle_epi8(popcnt_lut, _mm256_and_si256(_mm256_srli_epi16(dec, 4), nibble)));
+        for (int k = 0; k <= rows; k++) {
+            acc[k] = _mm256_sub_epi8(acc[k], _mm256_cmpeq_epi8(pc, _mm256_set1_epi8((char)k)));
+        }
+        if (++pending_rounds == 255) { // Antes de estourar os contadores de 8 bits
+            avx2_flush(acc, rows, counts);
+            pending_rounds = 0;
+        }
+    }
+    avx2_flush(acc, rows, counts);
+
+    _mm256_storeu_si256((__m256i *)r->s[0], s0);
+    _mm256_storeu_si256((__m256i *)r->s[1], s1);
+    _mm256_storeu_si256((__m256i *)r->s[2], s2);
+    _mm256_storeu_si256((__m256i *)r->s[3], s3);
+}
+
+bool binomial_simd_available(void) {
+    static int available = -1;
+    if (available < 0) available = __builtin_cpu_supports("avx2") ? 1 : 0;
+    return available;
+}
+
+#else
+
+bool binomial_simd_available(void) {
+    return false;
+}
+
+#endif
+
+/************ Entrada ************/
+int sampler_from_name(const char *name) {
+    if (strcmp(name, "scalar") == 0) return SAMPLER_SCALAR;
+    if (strcmp(name, "simd") == 0) return SAMPLER_SIMD;
+    if (strcmp(name, "lanes") == 0) return SAMPLER_LANES;
+    return -1;
+}
+
+void binomial_sample(galton_rng_lanes_t *r, uint32_t threshold, int rows, uint64_t balls,
+                     uint64_t *counts, bool allow_simd) {
+    if (balls == 0) return;
+    if (threshold == 0) { // Nenhuma decisão verdadeira
+        counts[0] += balls;
+        return;
+    }
+
+    uint64_t blocks = balls / BINOMIAL_BLOCK_BALLS;
+    int rem = (int)(balls % BINOMIAL_BLOCK_BALLS);
+    uint32_t last_mask[RNG_LANES];
+    uint32_t field_byte = (1u << rows) - 1;
+
+    // Última rodada parcial: só os primeiros 'rem' bytes têm decisões
+    for (int i = 0; i < RNG_LANES; i++) {
+        last_mask[i] = 0;
+        for (int byte = 0; byte < 4; byte++) {
+            if (i * 4 + byte < rem) last_mask[i] |= field_byte << (8 * byte);
+        }
+    }
+
+#if BINOMIAL_HAVE_AVX2
+    if (allow_simd && binomial_simd_available()) {
+        binomial_count_avx2(r, threshold, rows, blocks, rem ? last_mask : NULL, counts);
+    } else
+#endif
+    {
+        (void)allow_simd;
+        binomial_count_portable(r, threshold, rows, blocks, rem ? last_mask : NULL, counts);
+    }
+
+    if (rem) counts[0] -= BINOMIAL_BLOCK_BALLS - rem; // Bytes vazios da última rodada caíram no bin 0
+}
@@ -0,0 +1,57 @@
+// Comandos de texto pelo terminal USB
+
+#include <stdio.h>
+#include <string.h>
+#include "inc/galton_config.h"
+#include "inc/galton_command.h"
+#include "inc/galton_profile.h"
+
+/************ Execução ************/
+static bool command_board(const char *args) {
+    int rows, bins;
+    int spacing_h = PIN_SPACING_HORIZONTAL, spacing_v = PIN_SPACING_VERTICAL, bin_width = BIN_WIDTH;
+    int n = sscanf(args, "%d %d %d %d %d", &rows, &bins, &spacing_h, &spacing_v, &bin_width);
+
+    if (n != 2 && n != 5) {
+        printf("board: uso 'board R B [H V W]'\n");
+        return false;
+    }
+    if (!reconfigure_board(rows, bins, spacing_h, spacing_v, bin_width)) {
+        printf("board: %d linhas e %d caixas não cabem na tela (ou reprodução em andamento)\n", rows, bins);
+        return false;
+    }
+    printf("board=%d,%d,%d,%d,%d\n", PIN_ROW_COUNT, BIN_COUNT, PIN_SPACING_HORIZONTAL, PIN_SPACING_VERTICAL, BIN_WIDTH);
+    return true;
+}
+
+bool command_execute(const char *line) {
+    while (*line == ' ') line++;
+
+    if (strncmp(line, "board ", 6) == 0) return command_board(line + 6);
+    if (strcmp(line, "p") == 0) {
+        profile_request_summary();
+        return true;
+    }
+    return false;
+}
+
+/************ Leitura pela USB (firmware) ************/
+#ifndef GALTON_HOST
+void command_poll(void) {
+    static char line[COMMAND_MAX_LINE + 1];
+    static int length;
+    int c;
+
+    while ((c = getchar_timeout_us(0)) != PICO_ERROR_TIMEOUT) {
+        if (c == '\n' || c == '\r') {
+            line[length] = '\0';
+            if (length > 0 && !command_execute(line)) printf("?%s\n", line);
+            length = 0;
+        } else if (length == 0 && c == 'p') {
+            profile_request_summary(); // Sem esperar o Enter
+        } else if (length < COMMAND_MAX_LINE) {
+            line[length++] = (char)c;
+        }
+    }
+}
+#endif
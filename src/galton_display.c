@@ -35,6 +35,21 @@
 
 // Renderização e inicialização
 #include "inc/galton_config.h" // Inclui configurações e definições necessárias do projeto Galton Board
+#include "inc/galton_pipeline.h" // Fotografias do estado trocadas entre os núcleos
+#include "inc/galton_scheduler.h" // Passo fixo da física desacoplado da taxa de quadros
+#include "inc/galton_profile.h"   // Tempos de simulação, desenho e envio ao display
+#include "inc/galton_stats.h"     // Histograma sem perdas e escala das barras
+#include "inc/galton_board.h"     // Geometria da placa da tela (main_board)
+#include "inc/galton_telemetry.h" // Pousos em quadros binários pela USB
+#include "inc/galton_replay.h"    // Gravação/reprodução: semente, parâmetros iniciais e botões
+#include "inc/galton_geometry.h"  // Camada estática da variante compilada
+#include "inc/galton_command.h"   // Comandos pelo terminal USB (tamanho da placa)
+#include "inc/galton_text.h"      // Campos de texto do topo, sem printf de float
+#include "inc/galton_input.h"     // Botões por interrupção
+#include "hardware/sync.h"        // __wfe/__sev: o núcleo da tela dorme sem fotografia nova
+#if GALTON_DUAL_CORE && !defined(GALTON_HOST)
+#include "pico/multicore.h"
+#endif
 
 // Função principal de configuração do sistema
 void setup() {
@@ -47,6 +62,7 @@ void setup() {
     gpio_pull_up(SDA_PIN); // Habilita pull-up interno no SDA (necessário para I2C)
     gpio_pull_up(SCL_PIN); // Habilita pull-up interno no SCL
     ssd1306_init(); // Inicializa o display OLED SSD1306
+    ssd1306_invalidate(); // O primeiro quadro é enviado inteiro (o DMA é iniciado pelo núcleo que renderiza)
     memset(oled_buffer, 0, SSD1306_BUFFER_SIZE); // Limpa o buffer de imagem do display (preenche com zeros)
 
     // -------- CONFIGURAÇÃO DOS BOTÕES --------
@@ -56,132 +72,189 @@ void setup() {
     gpio_set_dir(BUTTON_B_PIN, GPIO_IN); // Define botão B como entrada
     gpio_pull_up(BUTTON_A_PIN); // Habilita resistor de pull-up interno para botão A
     gpio_pull_up(BUTTON_B_PIN); // Habilita resistor de pull-up interno para botão B
-    last_button_time = get_absolute_time(); // Salva o tempo atual para controle de debounce
-
-    // -------- GEOMETRIA DA GALTON BOARD --------
-    int total_width = NUM_BINS * BIN_WIDTH; // Largura total das canaletas (bins)
-    WALL_LEFT = (OLED_WIDTH - total_width) / 2 - WALL_OFFSET; // Calcula posição da parede esquerda
-    WALL_RIGHT = WALL_LEFT + total_width + 2 * WALL_OFFSET;   // Calcula posição da parede direita
-    CHUTE_LEFT = OLED_WIDTH / 2 - CHUTE_WIDTH / 2; // Canaleta central (entrada de bolas)
-    CHUTE_RIGHT = OLED_WIDTH / 2 + CHUTE_WIDTH / 2;
-
-    // -------- INICIALIZA POSIÇÃO DOS PINOS --------
-    int idx = 0; // Índice global dos pinos
-    for (int row = 0; row < PIN_ROWS; row++) { // Para cada linha de pinos
-        int pins_in_row = row + 1; // Quantidade de pinos na linha (formato triangular)
-        int start_x = OLED_WIDTH / 2 - (pins_in_row - 1) * PIN_SPACING_HORIZONTAL / 2; // Centraliza linha
-
-        for (int col = 0; col < pins_in_row; col++) { // Para cada pino da linha
-            pins[idx].x = start_x + col * PIN_SPACING_HORIZONTAL; // Calcula posição X do pino
-            pins[idx].y = 15 + row * PIN_SPACING_VERTICAL;         // Calcula posição Y do pino
-            idx++; // Avança índice
-        }
+    input_init(); // Bordas dos botões por interrupção, enfileiradas para check_buttons()
+
+    // -------- PLACA: GEOMETRIA, PINOS, HISTOGRAMA E ALEATORIEDADE --------
+    if (replay.mode == REPLAY_PLAYING) replay_apply_header(&replay); // Semente e parâmetros da gravação
+    uint64_t seed = RNG_SEED ? RNG_SEED : to_us_since_boot(get_absolute_time()); // Semente explícita ou pelo relógio
+    if (replay.mode == REPLAY_RECORDING) replay_record_begin(&replay, seed); // Grava a semente realmente usada
+    init_main_board(seed);     // Paredes, pinos e viés a partir dos parâmetros globais
+    invalidate_static_layer(); // Geometria nova: a camada estática é refeita no próximo quadro
+    profile_init();              // Zera os anéis de medição (se GALTON_PROFILE)
+}
+
+// Desenha um círculo cheio como uma linha horizontal por linha de pixels
+static void draw_disc(uint8_t *buffer, int cx, int cy, int radius) {
+    for (int dy = -radius; dy <= radius; dy++) {
+        int span = 0;
+        while ((span + 1) * (span + 1) + dy * dy <= radius * radius) span++; // Maior dx dentro do círculo
+        ssd1306_draw_hspan(buffer, cx - span, cx + span, cy + dy, true);
     }
+}
 
-    // -------- INICIALIZA HISTOGRAMA E ALEATORIEDADE --------
-    memset(histogram, 0, sizeof(uint16_t) * NUM_BINS); // Zera os valores do histograma
-    total_particles = 0; // Zera contador de partículas
-    last_particle_time = get_absolute_time(); // Tempo da última partícula lançada
-    last_button_time = get_absolute_time();   // Tempo do último botão pressionado
-    srand(to_us_since_boot(get_absolute_time())); // Semente para geração aleatória baseada no tempo atual
+// Camada estática (canaleta, paredes, divisórias e pinos): só muda quando a geometria muda
+static uint8_t static_layer[SSD1306_BUFFER_SIZE];
+static volatile bool static_layer_valid = false;
+static uint32_t static_layer_version; // Versão da geometria (galton_layout_t) quando a camada foi desenhada
+
+// Marca a camada estática para ser redesenhada no próximo quadro (chamar após mudar a geometria)
+void invalidate_static_layer() {
+    static_layer_valid = false;
 }
 
-// Função que renderiza toda a tela OLED a cada quadro
-void render_oled() {
-    memset(oled_buffer, 0, SSD1306_BUFFER_SIZE); // Limpa buffer do display (preto)
+// Desenha uma vez os elementos que não mudam entre quadros, a partir da geometria publicada
+// na fotografia (nunca de main_board, que o núcleo da simulação reescreve ao trocar o tamanho)
+static void build_static_layer(const galton_layout_t *l) {
+    static_layer_version = l->version;
 
-    // --- DESENHA CANALETA CENTRAL ---
-    for (int x = CHUTE_LEFT; x <= CHUTE_RIGHT; x++) {
-        for (int y = 0; y < 5; y++) {
-            ssd1306_set_pixel(oled_buffer, x, y, true); // Marca pixels da canaleta de entrada
-        }
+    // Variante compilada: a camada já está pronta na flash
+    if (l->static_geometry && MAX_HISTOGRAM_HEIGHT == BOARD_MAX_HISTOGRAM_HEIGHT) {
+        memcpy(static_layer, board_static.layer, SSD1306_BUFFER_SIZE);
+        static_layer_valid = true;
+        return;
     }
 
+    memset(static_layer, 0, SSD1306_BUFFER_SIZE);
+
+    // --- DESENHA CANALETA CENTRAL ---
+    ssd1306_fill_rect(static_layer, l->chute_left, 0, l->chute_right - l->chute_left + 1, 5, true);
+
     // --- DESENHA PAREDES LATERAIS ---
-    for (int y = 0; y < OLED_HEIGHT; y++) {
-        ssd1306_set_pixel(oled_buffer, WALL_LEFT, y, true);  // Parede esquerda
-        ssd1306_set_pixel(oled_buffer, WALL_RIGHT, y, true); // Parede direita
-    }
+    ssd1306_draw_vspan(static_layer, l->wall_left, 0, OLED_HEIGHT - 1, true);  // Parede esquerda
+    ssd1306_draw_vspan(static_layer, l->wall_right, 0, OLED_HEIGHT - 1, true); // Parede direita
 
     // --- DESENHA DIVISÓRIAS DAS CANALETAS (BINS) ---
-    for (int i = 0; i <= NUM_BINS; i++) {
-        int x = WALL_LEFT + WALL_OFFSET + i * BIN_WIDTH;
-        for (int y = HISTOGRAM_BASE_Y - MAX_HISTOGRAM_HEIGHT; y < OLED_HEIGHT; y++) {
-            ssd1306_set_pixel(oled_buffer, x, y, true); // Linha vertical da divisória
-        }
+    for (int i = 0; i <= l->num_bins; i++) {
+        int x = l->bins_left + i * l->bin_width;
+        ssd1306_draw_vspan(static_layer, x, l->histogram_base_y - MAX_HISTOGRAM_HEIGHT, OLED_HEIGHT - 1, true);
     }
 
     // --- DESENHA OS PINOS ---
-    for (int i = 0; i < (PIN_ROWS * (PIN_ROWS + 1) / 2); i++) {
-        int radius = PIN_DIAMETER / 2;
-        for (int dy = -radius; dy <= radius; dy++) {
-            for (int dx = -radius; dx <= radius; dx++) {
-                if (dx*dx + dy*dy <= radius*radius) { // Verifica se está dentro do círculo
-                    int px = pins[i].x + dx;
-                    int py = pins[i].y + dy;
-                    if (px >= 0 && px < OLED_WIDTH && py >= 0 && py < OLED_HEIGHT) {
-                        ssd1306_set_pixel(oled_buffer, px, py, true); // Marca pixel do pino
-                    }
-                }
-            }
-        }
+    for (int i = 0; i < l->num_pins; i++) {
+        draw_disc(static_layer, l->pin_x[i], l->pin_y[i], l->pin_radius);
     }
 
+    static_layer_valid = true;
+}
+
+// Campos do topo da tela ("B:" alinhado pela direita, para caber "B:10")
+static text_field_t status_balls = {.x = 2, .y = 2, .prefix = "A:"};
+static text_field_t status_total = {.x = 2, .y = 12, .prefix = "T:"};
+static text_field_t status_bias = {.x = OLED_WIDTH, .y = 2, .prefix = "B:", .right_aligned = true};
+
+// Desenha um quadro a partir de uma fotografia do estado da simulação
+static void render_snapshot(const galton_snapshot_t *snap) {
+    PROFILE_START(render_start);
+
+    // --- COPIA A CAMADA ESTÁTICA (CANALETA, PAREDES, DIVISÓRIAS E PINOS) ---
+    const galton_layout_t *layout = &snap->layout;
+    if (!static_layer_valid || static_layer_version != layout->version) build_static_layer(layout); // Placa mudou de tamanho
+    memcpy(oled_buffer, static_layer, SSD1306_BUFFER_SIZE);
+
     // --- DESENHA AS PARTÍCULAS (BOLAS) ---
-    for (int i = 0; i < MAX_PARTICLES; i++) {
-        if (particles[i].active) { // Se a partícula está ativa
-            int radius = BALL_DIAMETER / 2;
-            for (int dy = -radius; dy <= radius; dy++) {
-                for (int dx = -radius; dx <= radius; dx++) {
-                    if (dx*dx + dy*dy <= radius*radius) {
-                        int px = (int)particles[i].x + dx;
-                        int py = (int)particles[i].y + dy;
-                        if (px >= 0 && px < OLED_WIDTH && py >= 0 && py < OLED_HEIGHT) {
-                            ssd1306_set_pixel(oled_buffer, px, py, true); // Marca pixel da partícula
-                        }
-                    }
-                }
-            }
+    if (BALL_DIAMETER / 2 == 0) {
+        ssd1306_plot_points(oled_buffer, snap->ball_x, snap->ball_y, snap->ball_count); // Um pixel por bola
+    } else {
+        for (int i = 0; i < snap->ball_count; i++) {
+            draw_disc(oled_buffer, snap->ball_x[i], snap->ball_y[i], BALL_DIAMETER / 2);
         }
     }
 
     // --- DESENHA O HISTOGRAMA ---
-    for (int i = 0; i < NUM_BINS; i++) {
-        int bar_height = histogram[i]; // Altura da barra atual
-        int start_x = WALL_LEFT + WALL_OFFSET + i * BIN_WIDTH + 1;
-        for (int h = 0; h < bar_height; h++) {
-            for (int w = 1; w < BIN_WIDTH - 1; w++) {
-                ssd1306_set_pixel(oled_buffer, start_x + w, HISTOGRAM_BASE_Y - h, true); // Preenche barra
-            }
-        }
+    for (int i = 0; i < layout->num_bins; i++) { // Geometria da fotografia: a placa pode ter mudado desde então
+        int bar_height = histogram_bar_height(snap->histogram[i], snap->histogram_max, MAX_HISTOGRAM_HEIGHT); // Escala só na tela
+        int start_x = layout->bins_left + i * layout->bin_width + 1;
+        ssd1306_fill_rect(oled_buffer, start_x + 1, layout->histogram_base_y - bar_height + 1, layout->bin_width - 2, bar_height, true);
     }
 
     // --- EXIBE INFORMAÇÕES NO TOPO DA TELA ---
-    char info_str[16];
-    snprintf(info_str, sizeof(info_str), "A:%d", BALLS_PER_DROP); // Quantidade de bolas por lançamento
-    ssd1306_draw_string(oled_buffer, 2, 2, info_str);
-
-    snprintf(info_str, sizeof(info_str), "T:%lu", total_particles); // Total de bolas lançadas
-    ssd1306_draw_string(oled_buffer, 2, 12, info_str);
+    // Só refaz o texto de um campo quando o valor muda; nos outros quadros copia as colunas em cache
+    text_field_set(&status_balls, snap->balls_per_drop);      // Quantidade de bolas por lançamento
+    text_field_set(&status_total, (int64_t)snap->total_particles); // Total de bolas lançadas
+    text_field_set(&status_bias, snap->balance_bias);         // Viés da simulação (desbalanceamento)
+    text_field_draw(&status_balls, oled_buffer);
+    text_field_draw(&status_total, oled_buffer);
+    text_field_draw(&status_bias, oled_buffer);
 
-    snprintf(info_str, sizeof(info_str), "B:%.0f", BALANCE_BIAS); // Viés da simulação (desbalanceamento)
-    ssd1306_draw_string(oled_buffer, OLED_WIDTH - 24, 2, info_str);
+    PROFILE_STOP(render_start, PROF_RENDER);
 
     // --- FINALIZA E EXIBE NA TELA ---
-    calculate_render_area_buffer_length(&oled_area); // Calcula área útil do buffer
-    render_on_display(oled_buffer, &oled_area);      // Envia buffer para o display
+    PROFILE_START(display_start);
+    render_dirty_on_display_dma(oled_buffer); // Envia por DMA só as páginas/colunas que mudaram desde o último quadro
+    PROFILE_STOP(display_start, PROF_DISPLAY);
+}
+
+// Renderiza o estado atual da simulação no mesmo núcleo (sem passar pela fila)
+void render_oled() {
+    static galton_snapshot_t snap;
+    snapshot_capture(&snap, 0);
+    render_snapshot(&snap);
+}
+
+// Desenha a fotografia mais recente publicada pela simulação (false se não havia nada novo)
+bool render_latest_snapshot() {
+    const galton_snapshot_t *snap = snapshot_queue_acquire_latest(&snapshot_queue);
+    if (!snap) return false;
+
+    render_snapshot(snap); // O quadro é copiado para o buffer de DMA antes de liberar a fotografia
+    snapshot_queue_release(&snapshot_queue);
+    return true;
+}
+
+// Laço do núcleo 1: I2C/DMA e desenho, sem nunca bloquear a simulação
+void render_core_main() {
+    ssd1306_dma_init(); // A interrupção de fim de DMA fica no núcleo que renderiza
+    profile_init_core(); // SysTick deste núcleo: PROF_RENDER e PROF_DISPLAY são medidos aqui
+    while (true) {
+        if (!render_latest_snapshot()) {
+            __wfe(); // Nada novo: dorme até o __sev() da próxima fotografia (ou a IRQ do DMA)
+        }
+    }
+}
+
+// Função principal (no build nativo o main fica em host/galton_host.c)
+#ifndef GALTON_HOST
+static galton_scheduler_t scheduler; // Passo fixo da física e taxa de quadros
+
+#if GALTON_DUAL_CORE
+// Quadro no núcleo 0: só publica a fotografia; o núcleo 1 desenha
+static void publish_snapshot() {
+    snapshot_queue_push_current(&snapshot_queue, scheduler.steps); // Nunca espera pela tela
+    __sev(); // Acorda o núcleo 1
 }
+#endif
 
-// Função principal
 int main() {
     setup(); // Inicializa o sistema
 
-    // Loop infinito de execução
+#if GALTON_DUAL_CORE
+    multicore_launch_core1(render_core_main); // Núcleo 1 cuida da tela
+
+    // Núcleo 0: só simulação; a cada quadro publica uma fotografia para o núcleo 1
+    scheduler_init(&scheduler, TICK_DELAY_MS, TARGET_FPS);
+    scheduler_set_idle(&scheduler, idle_steps, skip_idle_steps, input_pending); // Placa parada: dorme até o lançamento ou um botão
+    while (true) {
+        scheduler_run_once(&scheduler, update_particles, publish_snapshot);
+        profile_poll(); // Resumo de tempos pela USB (se GALTON_PROFILE)
+        telemetry_poll(); // Quadros de pousos pela USB (se GALTON_TELEMETRY)
+        replay_poll();    // Gravação em hex pela USB (se GALTON_REPLAY)
+        command_poll();   // Comandos pelo terminal USB (ex.: "board 7 8")
+    }
+#else
+    ssd1306_dma_init(); // Quadros vão por DMA enquanto o próximo é simulado
+
+    // Loop infinito: passos de física no ritmo fixo, quadros quando houver tempo
+    scheduler_init(&scheduler, TICK_DELAY_MS, TARGET_FPS);
+    scheduler_set_idle(&scheduler, idle_steps, skip_idle_steps, input_pending); // Placa parada: dorme até o lançamento ou um botão
     while (true) {
-        update_particles(); // Atualiza a posição das partículas
-        render_oled();      // Atualiza o display com nova renderização
-        sleep_ms(TICK_DELAY_MS); // Espera um tempo para manter FPS controlado
+        scheduler_run_once(&scheduler, update_particles, render_oled);
+        profile_poll(); // Resumo de tempos pela USB (se GALTON_PROFILE)
+        telemetry_poll(); // Quadros de pousos pela USB (se GALTON_TELEMETRY)
+        replay_poll();    // Gravação em hex pela USB (se GALTON_REPLAY)
+        command_poll();   // Comandos pelo terminal USB (ex.: "board 7 8")
     }
+#endif
 
     return 0;
 }
+#endif // GALTON_HOST
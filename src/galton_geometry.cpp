@@ -0,0 +1,155 @@
+// Tabelas da geometria da placa geradas em tempo de compilação (C++17 constexpr)
+//
+// BoardVariant descreve uma placa só com parâmetros de template; make_tables() repete,
+// em constexpr, os mesmos cálculos de board_init(), board_check_pin_collisions() e
+// build_static_layer(), e o resultado vira um objeto constante (flash). O laço de
+// colisão é instanciado para a variante, então raio, espaçamentos e limites são constantes.
+
+extern "C" {
+#include "inc/galton_config.h"
+#include "inc/galton_geometry.h"
+}
+
+namespace {
+
+/************ Descrição de uma variante ************/
+template <int Rows, int Bins, int PinDiameter, int SpacingH, int SpacingV, int ChuteWidth, int BinWidth,
+          int WallOffset, int HistogramBaseY, int HistogramHeight, int Width, int Height>
+struct BoardVariant {
+    static constexpr int rows = Rows;
+    static constexpr int bins = Bins;
+    static constexpr int width = Width;
+    static constexpr int height = Height;
+    static constexpr int pin_radius = PinDiameter / 2;                 // Raio desenhado
+    static constexpr int hit_radius = (PinDiameter + BALL_DIAMETER) / 2; // Raio de colisão com a bola
+    static constexpr int spacing_h = SpacingH;
+    static constexpr int spacing_v = SpacingV;
+    static constexpr int bin_width = BinWidth;
+    static constexpr int wall_offset = WallOffset;
+    static constexpr int histogram_base_y = HistogramBaseY;
+    static constexpr int histogram_height = HistogramHeight;
+
+    static constexpr int wall_left = (Width - Bins * BinWidth) / 2 - WallOffset;
+    static constexpr int wall_right = wall_left + Bins * BinWidth + 2 * WallOffset;
+    static constexpr int chute_left = Width / 2 - ChuteWidth / 2;
+    static constexpr int chute_right = Width / 2 + ChuteWidth / 2;
+
+    static constexpr int pin_x(int row, int col) { return Width / 2 - row * SpacingH / 2 + col * SpacingH; }
+    static constexpr int pin_y(int row) { return PIN_TOP_Y + row * SpacingV; }
+
+    static_assert(Rows * (Rows + 1) / 2 < BOARD_NO_PIN && Bins <= 255, "tabelas de 8 bits");
+};
+
+using DefaultBoard = BoardVariant<PIN_ROWS, NUM_BINS, BOARD_PIN_DIAMETER, BOARD_PIN_SPACING_H, BOARD_PIN_SPACING_V,
+                                  BOARD_CHUTE_WIDTH, BOARD_BIN_WIDTH, BOARD_WALL_OFFSET, BOARD_HISTOGRAM_BASE_Y,
+                                  BOARD_MAX_HISTOGRAM_HEIGHT, OLED_WIDTH, OLED_HEIGHT>;
+
+/************ Desenho em constexpr (mesmo resultado de ssd1306_fill_rect) ************/
+constexpr void fill_rect(uint8_t *layer, int x, int y, int w, int h) {
+    int x0 = x < 0 ? 0 : x;
+    int y0 = y < 0 ? 0 : y;
+    int x1 = x + w - 1 >= OLED_WIDTH ? OLED_WIDTH - 1 : x + w - 1;
+    int y1 = y + h - 1 >= OLED_HEIGHT ? OLED_HEIGHT - 1 : y + h - 1;
+
+    for (int py = y0; py <= y1; py++) {
+        for (int px = x0; px <= x1; px++) layer[(py >> 3) * OLED_WIDTH + px] |= (uint8_t)(1u << (py & 7));
+    }
+}
+
+constexpr void draw_disc(uint8_t *layer, int cx, int cy, int radius) {
+    for (int dy = -radius; dy <= radius; dy++) {
+        int span = 0;
+        while ((span + 1) * (span + 1) + dy * dy <= radius * radius) span++;
+        fill_rect(layer, cx - span, cy + dy, 2 * span + 1, 1);
+    }
+}
+
+// Mesma conta de lattice_range() em galton_simulation.c
+constexpr void lattice_range(int rel, int radius, int spacing, int count, uint8_t *lo, uint8_t *hi) {
+    int l = rel - radius <= 0 ? 0 : (rel - radius + spacing - 1) / spacing;
+    int h = (rel + radius) / spacing;
+    if (h >= count) h = count - 1;
+
+    if (rel + radius < 0 || l > h) {
+        *lo = BOARD_NO_PIN;
+        *hi = 0;
+    } else {
+        *lo = (uint8_t)l;
+        *hi = (uint8_t)h;
+    }
+}
+
+/************ Geração das tabelas ************/
+template <class V>
+constexpr board_static_tables_t make_tables() {
+    board_static_tables_t t{};
+
+    t.wall_left = V::wall_left;
+    t.wall_right = V::wall_right;
+    t.chute_left = V::chute_left;
+    t.chute_right = V::chute_right;
+
+    int idx = 0;
+    for (int row = 0; row < V::rows; row++) {
+        for (int col = 0; col <= row; col++) t.pins[idx++] = Pin{V::pin_x(row, col), V::pin_y(row)};
+    }
+
+    for (int x = 0; x < V::width; x++) {
+        int bin = (x - V::wall_left - V::wall_offset) / V::bin_width;
+        t.bin_of_x[x] = (uint8_t)(bin < 0 ? 0 : (bin >= V::bins ? V::bins - 1 : bin));
+    }
+
+    for (int y = 0; y < V::height; y++) {
+        lattice_range(y - PIN_TOP_Y, V::hit_radius, V::spacing_v, V::rows, &t.row_lo[y], &t.row_hi[y]);
+    }
+    for (int row = 0; row < V::rows; row++) {
+        for (int x = 0; x < V::width; x++) {
+            lattice_range(x - V::pin_x(row, 0), V::hit_radius, V::spacing_h, row + 1, &t.col_lo[row][x], &t.col_hi[row][x]);
+        }
+    }
+
+    // Camada estática: canaleta, paredes, divisórias e pinos (como build_static_layer)
+    fill_rect(t.layer, V::chute_left, 0, V::chute_right - V::chute_left + 1, 5);
+    fill_rect(t.layer, V::wall_left, 0, 1, V::height);
+    fill_rect(t.layer, V::wall_right, 0, 1, V::height);
+    for (int i = 0; i <= V::bins; i++) {
+        int top = V::histogram_base_y - V::histogram_height;
+        fill_rect(t.layer, V::wall_left + V::wall_offset + i * V::bin_width, top, 1, V::height - top);
+    }
+    for (int i = 0; i < idx; i++) draw_disc(t.layer, t.pins[i].x, t.pins[i].y, V::pin_radius);
+
+    return t;
+}
+
+constexpr board_static_tables_t default_tables = make_tables<DefaultBoard>(); // Erro de compilação se não couber em constexpr
+
+/************ Busca de colisão especializada ************/
+template <class V>
+inline int pin_hit(const board_static_tables_t &t, phys_t x, phys_t y) {
+    unsigned px = (unsigned)PHYS_TO_INT(x);
+    unsigned py = (unsigned)PHYS_TO_INT(y);
+
+    if (px >= (unsigned)V::width || py >= (unsigned)V::height) return BOARD_OUTSIDE_TABLES; // Fora da tela
+
+    for (int row = t.row_lo[py]; row <= t.row_hi[py]; row++) {
+        int first = row * (row + 1) / 2;
+        for (int i = first + t.col_lo[row][px]; i <= first + t.col_hi[row][px]; i++) {
+            phys_t dx = x - PHYS_FROM_INT(t.pins[i].x);
+            phys_t dy = y - PHYS_FROM_INT(t.pins[i].y);
+            if (phys_dist2_lt(dx, dy, V::hit_radius)) return i;
+        }
+    }
+    return -1;
+}
+
+} // namespace
+
+extern "C" {
+
+const board_static_tables_t board_static = default_tables; // Inicialização constante: vai para a flash
+
+int board_static_pin_hit(phys_t x, phys_t y) {
+    return pin_hit<DefaultBoard>(board_static, x, y);
+}
+
+}
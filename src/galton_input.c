@@ -0,0 +1,139 @@
+// Botões por interrupção: fila de bordas e reconhecimento de gestos
+
+#include "inc/galton_config.h"
+#include "inc/galton_input.h"
+
+#define INPUT_BOTH (INPUT_TAP_A | INPUT_TAP_B)
+
+input_queue_t input_queue;
+
+/************ Fila de eventos ************/
+bool input_queue_push(input_queue_t *q, const input_event_t *e) {
+    unsigned head = atomic_load_explicit(&q->head, memory_order_relaxed);
+    unsigned tail = atomic_load_explicit(&q->tail, memory_order_acquire);
+
+    if (head - tail >= INPUT_QUEUE_SIZE) {
+        q->dropped++;
+        return false;
+    }
+    q->events[head % INPUT_QUEUE_SIZE] = *e;
+    atomic_store_explicit(&q->head, head + 1, memory_order_release); // Evento visível antes do índice
+    return true;
+}
+
+const input_event_t *input_queue_peek(input_queue_t *q) {
+    unsigned tail = atomic_load_explicit(&q->tail, memory_order_relaxed);
+
+    if (atomic_load_explicit(&q->head, memory_order_acquire) == tail) return NULL;
+    return &q->events[tail % INPUT_QUEUE_SIZE];
+}
+
+void input_queue_pop(input_queue_t *q) {
+    unsigned tail = atomic_load_explicit(&q->tail, memory_order_relaxed);
+    atomic_store_explicit(&q->tail, tail + 1, memory_order_release);
+}
+
+/************ Tratador da IRQ de GPIO ************/
+static uint32_t edge_time_us[2]; // Última borda aceita de cada botão
+static bool edge_seen[2];
+
+static void input_gpio_irq(unsigned int gpio, uint32_t events) {
+    int button = gpio == BUTTON_A_PIN ? 0 : gpio == BUTTON_B_PIN ? 1 : -1;
+    if (button < 0) return;
+
+    uint32_t now = time_us_32();
+    if (edge_seen[button] && now - edge_time_us[button] < INPUT_DEBOUNCE_MS * 1000u) return; // Ricochete
+
+    input_event_t e = {.time_us = now, .button = (uint8_t)button};
+    if ((events & (GPIO_IRQ_EDGE_FALL | GPIO_IRQ_EDGE_RISE)) == GPIO_IRQ_EDGE_FALL) e.pressed = true;
+    else if ((events & (GPIO_IRQ_EDGE_FALL | GPIO_IRQ_EDGE_RISE)) == GPIO_IRQ_EDGE_RISE) e.pressed = false;
+    else e.pressed = !gpio_get(gpio); // As duas bordas antes do atendimento: vale o nível atual
+
+    edge_time_us[button] = now;
+    edge_seen[button] = true;
+    input_queue_push(&input_queue, &e);
+}
+
+void input_init(void) {
+    // Um callback para todos os pinos do núcleo que chama (o mesmo que roda check_buttons)
+    gpio_set_irq_enabled_with_callback(BUTTON_A_PIN, GPIO_IRQ_EDGE_FALL | GPIO_IRQ_EDGE_RISE, true, input_gpio_irq);
+    gpio_set_irq_enabled(BUTTON_B_PIN, GPIO_IRQ_EDGE_FALL | GPIO_IRQ_EDGE_RISE, true);
+}
+
+/************ Gestos (consumidor) ************/
+static struct {
+    uint8_t held;         // Botões apertados agora (INPUT_TAP_*)
+    uint8_t pressed;      // Botões apertados desde o início do gesto
+    bool fired;           // Gesto longo já emitido: espera soltar todos
+    uint32_t start_us;    // Início do gesto (ou do acorde, quando o segundo botão desceu)
+    uint32_t press_us[2]; // Borda de descida de cada botão segurado
+} gesture;
+
+bool input_pending(void) {
+    return gesture.held || !input_queue_empty(&input_queue);
+}
+
+// Gesto longo vencido em 'now' (uma vez por gesto), ou 0
+static int gesture_timeout(uint32_t now) {
+    if (!gesture.held || gesture.fired) return 0;
+
+    bool chord = gesture.pressed == INPUT_BOTH;
+    int32_t hold_us = (chord ? CHORD_HOLD_MS : LONG_PRESS_MS) * 1000;
+    if ((int32_t)(now - gesture.start_us) < hold_us) return 0; // Com sinal: now pode anteceder start_us
+
+    gesture.fired = true;
+    if (chord) return INPUT_CHORD_HOLD;
+    return gesture.pressed == INPUT_TAP_A ? INPUT_LONG_A : INPUT_LONG_B;
+}
+
+// Aplica uma borda; retorna o toque concluído ao soltar o último botão, ou 0
+static int gesture_edge(int button, bool pressed, uint32_t time_us) {
+    uint8_t bit = (uint8_t)(1u << button);
+
+    if (pressed) {
+        if (gesture.held & bit) return 0; // Repetida
+        if (!gesture.held) {
+            gesture.pressed = 0;
+            gesture.fired = false;
+            gesture.start_us = time_us;
+        }
+        gesture.held |= bit;
+        gesture.pressed |= bit;
+        gesture.press_us[button] = time_us;
+        if (gesture.held == INPUT_BOTH && !gesture.fired) gesture.start_us = time_us; // O acorde conta daqui
+        return 0;
+    }
+
+    if (!(gesture.held & bit)) return 0; // Solto sem ter sido visto descer
+    gesture.held &= (uint8_t)~bit;
+    if (gesture.held || gesture.fired) return 0;
+    return gesture.pressed; // Toque: A, B ou os dois
+}
+
+// Botão segurado cujo pino já lê solto: a borda de subida caiu na janela de ricochete
+static int gesture_check_levels(uint32_t now) {
+    static const unsigned int pins[2] = {BUTTON_A_PIN, BUTTON_B_PIN};
+    int result = 0;
+
+    for (int button = 0; button < 2; button++) {
+        if (!(gesture.held & (1u << button)) || !gpio_get(pins[button])) continue;
+        if (now - gesture.press_us[button] < INPUT_DEBOUNCE_MS * 1000u) continue; // Ainda pode ricochetear
+        result |= gesture_edge(button, false, now);
+    }
+    return result;
+}
+
+int input_next_gesture(uint32_t now_us) {
+    const input_event_t *e;
+    int result;
+
+    // Cada evento vale no tempo da sua borda: um toque longo vencido antes dele sai primeiro
+    while ((e = input_queue_peek(&input_queue)) != NULL) {
+        if ((result = gesture_timeout(e->time_us)) != 0) return result;
+        result = gesture_edge(e->button, e->pressed, e->time_us);
+        input_queue_pop(&input_queue);
+        if (result) return result;
+    }
+    if ((result = gesture_timeout(now_us)) != 0) return result;
+    return gesture_check_levels(now_us);
+}
@@ -0,0 +1,108 @@
+// Fila sem travas entre a simulação e a renderização
+
+#include "inc/galton_config.h"
+#include "inc/galton_pipeline.h"
+#include "inc/galton_stats.h"
+#include "inc/galton_board.h"
+
+snapshot_queue_t snapshot_queue;
+
+/************ Fotografia do estado ************/
+// Copia a geometria da placa (a posição da fila guarda a última cópia; só muda com a versão)
+static void layout_capture(galton_layout_t *l, const galton_board_t *b) {
+    l->version = b->geometry_version;
+    l->static_geometry = b->static_geometry;
+    l->wall_left = b->wall_left;
+    l->wall_right = b->wall_right;
+    l->chute_left = b->chute_left;
+    l->chute_right = b->chute_right;
+    l->num_bins = b->params.num_bins;
+    l->bins_left = b->wall_left + b->params.wall_offset;
+    l->bin_width = b->params.bin_width;
+    l->histogram_base_y = b->params.histogram_base_y;
+    l->pin_radius = b->params.pin_diameter / 2;
+    l->num_pins = b->num_pins;
+    for (int i = 0; i < b->num_pins; i++) { // board_params_valid mantém os pinos na tela; o limite só evita o estouro
+        int x = b->pins[i].x, y = b->pins[i].y;
+        l->pin_x[i] = (uint8_t)(x < 0 ? 0 : x >= OLED_WIDTH ? OLED_WIDTH - 1 : x);
+        l->pin_y[i] = (uint8_t)(y < 0 ? 0 : y >= OLED_HEIGHT ? OLED_HEIGHT - 1 : y);
+    }
+    l->valid = true;
+}
+
+void snapshot_capture(galton_snapshot_t *snap, uint32_t sequence) {
+    const ParticlePool *particles = &main_board.particles;
+    int count = particles->count < SNAPSHOT_MAX_BALLS ? particles->count : SNAPSHOT_MAX_BALLS;
+
+    snap->sequence = sequence;
+    snap->ball_count = 0;
+    for (int i = 0; i < count; i++) {
+        int x = PHYS_TO_INT(particles->x[i]);
+        int y = PHYS_TO_INT(particles->y[i]);
+        if (x < 0 || x >= OLED_WIDTH || y < 0 || y >= OLED_HEIGHT) continue; // Fora da tela
+        snap->ball_x[snap->ball_count] = (uint8_t)x;
+        snap->ball_y[snap->ball_count] = (uint8_t)y;
+        snap->ball_count++;
+    }
+
+    const galton_board_t *b = &main_board;
+    memcpy(snap->histogram, b->hist.bins, sizeof(snap->histogram[0]) * b->hist.num_bins);
+    snap->histogram_max = b->hist.max;
+    if (!snap->layout.valid || snap->layout.version != b->geometry_version) layout_capture(&snap->layout, b);
+    snap->total_particles = main_board.total_particles;
+    snap->balls_per_drop = BALLS_PER_DROP;
+    snap->balance_bias = (int)(BALANCE_BIAS + 0.5f); // Arredondado aqui: a tela não formata float
+}
+
+/************ Produtor (núcleo da simulação) ************/
+galton_snapshot_t *snapshot_queue_begin_write(snapshot_queue_t *q) {
+    unsigned head = atomic_load_explicit(&q->head, memory_order_relaxed);
+    unsigned tail = atomic_load_explicit(&q->tail, memory_order_acquire);
+
+    if (head - tail >= SNAPSHOT_QUEUE_SLOTS) return NULL; // Cheia: o consumidor ainda usa todas
+    return &q->slots[head % SNAPSHOT_QUEUE_SLOTS];
+}
+
+void snapshot_queue_publish(snapshot_queue_t *q) {
+    unsigned head = atomic_load_explicit(&q->head, memory_order_relaxed);
+    atomic_store_explicit(&q->head, head + 1, memory_order_release); // Conteúdo visível antes do índice
+}
+
+bool snapshot_queue_push_current(snapshot_queue_t *q, uint32_t sequence) {
+    galton_snapshot_t *slot = snapshot_queue_begin_write(q);
+
+    if (!slot) {
+        q->dropped++; // Nunca espera pela tela
+        return false;
+    }
+    snapshot_capture(slot, sequence);
+    snapshot_queue_publish(q);
+    return true;
+}
+
+/************ Consumidor (núcleo da renderização) ************/
+const galton_snapshot_t *snapshot_queue_acquire_latest(snapshot_queue_t *q) {
+    unsigned head = atomic_load_explicit(&q->head, memory_order_acquire);
+    unsigned tail = atomic_load_explicit(&q->tail, memory_order_relaxed);
+
+    if (head == tail) return NULL; // Nada novo
+
+    // Libera as fotografias antigas de uma vez e fica só com a mais recente
+    if (head - tail > 1) {
+        atomic_store_explicit(&q->tail, head - 1, memory_order_release);
+    }
+
+    const galton_snapshot_t *snap = &q->slots[(head - 1) % SNAPSHOT_QUEUE_SLOTS];
+    if (q->consumed > 0 && snap->sequence <= q->last_sequence) q->out_of_order++;
+    if (q->consumed > 0 && snap->layout.version < q->last_geometry_version) q->geometry_regressions++;
+    if (q->consumed > 0 && snap->layout.version > q->last_geometry_version) q->geometry_changes++;
+    q->last_sequence = snap->sequence;
+    q->last_geometry_version = snap->layout.version;
+    q->consumed++;
+    return snap;
+}
+
+void snapshot_queue_release(snapshot_queue_t *q) {
+    unsigned tail = atomic_load_explicit(&q->tail, memory_order_relaxed);
+    atomic_store_explicit(&q->tail, tail + 1, memory_order_release);
+}
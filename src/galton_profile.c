@@ -0,0 +1,107 @@
+// Anéis de amostras de tempo e resumo mín/média/p99
+
+#include "inc/galton_profile.h"
+
+#if GALTON_PROFILE
+
+#include <stdlib.h>
+#include "pico/stdlib.h"
+
+#ifdef GALTON_HOST
+#include <time.h>
+#else
+#include "hardware/clocks.h"
+#endif
+
+static profile_ring_t profile_rings[PROF_NUM_PHASES]; // Anéis estáticos, um por fase
+static uint32_t profile_scratch[PROFILE_RING_SIZE];   // Cópia ordenada para o percentil
+static bool profile_requested;                        // Resumo sob demanda (terminal USB)
+
+static const char *const profile_phase_names[PROF_NUM_PHASES] = {
+    "update", "collisions", "render", "display"
+};
+
+#ifdef GALTON_HOST
+uint32_t profile_now(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint32_t)((uint64_t)ts.tv_sec * 1000000000ull + (uint64_t)ts.tv_nsec);
+}
+#else
+uint32_t profile_ticks_per_us = 125;
+static absolute_time_t profile_last_report; // Último resumo periódico
+#endif
+
+void profile_init_core(void) {
+#ifndef GALTON_HOST
+    // SysTick livre a partir do clock do processador, recarregando no máximo (24 bits);
+    // o registrador é do núcleo que executa, então cada núcleo que mede passa por aqui
+    systick_hw->csr = 0;
+    systick_hw->rvr = 0x00FFFFFFu;
+    systick_hw->cvr = 0;
+    systick_hw->csr = 0x5; // ENABLE | CLKSOURCE=processador, sem interrupção
+#endif
+}
+
+void profile_init(void) {
+    for (int p = 0; p < PROF_NUM_PHASES; p++) profile_rings[p].count = 0;
+    profile_init_core();
+#ifndef GALTON_HOST
+    profile_ticks_per_us = clock_get_hz(clk_sys) / 1000000;
+    profile_last_report = get_absolute_time();
+#endif
+}
+
+void profile_record(profile_phase_t phase, uint32_t ticks) {
+    profile_ring_t *r = &profile_rings[phase];
+    r->samples[r->count & (PROFILE_RING_SIZE - 1)] = ticks;
+    r->count++;
+}
+
+static int compare_u32(const void *a, const void *b) {
+    uint32_t x = *(const uint32_t *)a, y = *(const uint32_t *)b;
+    return (x > y) - (x < y);
+}
+
+void profile_print_summary(FILE *out) {
+    fprintf(out, "profile: phase n min_us avg_us p99_us\n");
+
+    for (int p = 0; p < PROF_NUM_PHASES; p++) {
+        const profile_ring_t *r = &profile_rings[p];
+        uint32_t count = r->count;
+        int n = count < PROFILE_RING_SIZE ? (int)count : PROFILE_RING_SIZE;
+        if (n == 0) continue;
+
+        // Copia antes de ordenar: o outro núcleo pode continuar gravando no anel
+        uint64_t sum = 0;
+        for (int i = 0; i < n; i++) {
+            profile_scratch[i] = r->samples[i];
+            sum += profile_scratch[i];
+        }
+        qsort(profile_scratch, (size_t)n, sizeof(profile_scratch[0]), compare_u32);
+
+        float per_us = (float)PROFILE_TICKS_PER_US;
+        fprintf(out, "profile: %s %lu %.2f %.2f %.2f\n", profile_phase_names[p], (unsigned long)count,
+                profile_scratch[0] / per_us,
+                (float)sum / n / per_us,
+                profile_scratch[(n * 99) / 100] / per_us);
+    }
+}
+
+void profile_request_summary(void) {
+    profile_requested = true;
+}
+
+void profile_poll(void) {
+#ifndef GALTON_HOST
+    absolute_time_t now = get_absolute_time();
+
+    if (profile_requested || absolute_time_diff_us(profile_last_report, now) >= PROFILE_REPORT_MS * 1000ll) {
+        profile_print_summary(stdout);
+        profile_last_report = now;
+        profile_requested = false;
+    }
+#endif
+}
+
+#endif // GALTON_PROFILE
@@ -0,0 +1,279 @@
+// Gravação e reprodução: cabeçalho, eventos de botão e hash do estado
+
+#include <string.h>
+#include "inc/galton_replay.h"
+#include "inc/galton_geometry.h"
+
+#if GALTON_REPLAY && !defined(GALTON_HOST)
+#include <stdio.h>
+#include "pico/stdlib.h"
+#endif
+
+#define REPLAY_MAGIC "GRP2"
+#define REPLAY_MAGIC_V1 "GRP1"   // Gravações anteriores ao tamanho configurável
+#define REPLAY_HEADER_BYTES_V1 56
+#define FNV_OFFSET 0xCBF29CE484222325ull
+#define FNV_PRIME 0x100000001B3ull
+
+galton_replay_t replay = {.mode = GALTON_REPLAY ? REPLAY_RECORDING : REPLAY_OFF};
+
+/************ Gravação ************/
+void replay_record_begin(galton_replay_t *r, uint64_t seed) {
+    replay_header_t *h = &r->header;
+
+    memset(h, 0, sizeof(*h));
+    h->seed = seed;
+    h->balance_bias = BALANCE_BIAS;
+    h->balls_per_drop = BALLS_PER_DROP;
+    h->sim_mode = SIM_MODE;
+    h->sampler = BINOMIAL_SAMPLER;
+    h->tick_ms = TICK_DELAY_MS;
+    h->pin_rows = PIN_ROW_COUNT;
+    h->num_bins = BIN_COUNT;
+    h->pin_diameter = PIN_DIAMETER;
+    h->pin_spacing_h = PIN_SPACING_HORIZONTAL;
+    h->pin_spacing_v = PIN_SPACING_VERTICAL;
+    h->bin_width = BIN_WIDTH;
+#ifdef GALTON_FIXED_POINT
+    h->fixed_point = 1;
+#endif
+    h->capacity = MAX_PARTICLES;
+
+    r->mode = REPLAY_RECORDING;
+    r->length = 0;
+    r->cursor = 0;
+    r->last_tick = 0;
+    r->hash = FNV_OFFSET;
+}
+
+void replay_record_buttons(galton_replay_t *r, uint32_t tick, int buttons) {
+    uint8_t event[6];
+    uint32_t delta = tick - r->last_tick;
+    size_t n = 0;
+
+    while (delta >= 0x80) {
+        event[n++] = (uint8_t)(delta | 0x80);
+        delta >>= 7;
+    }
+    event[n++] = (uint8_t)delta;
+    event[n++] = (uint8_t)buttons;
+
+    if (r->header.truncated || r->length + n > sizeof(r->events)) {
+        r->header.truncated = 1; // A partir daqui a reprodução diverge; o hash final denuncia
+        return;
+    }
+    memcpy(r->events + r->length, event, n);
+    r->length += n;
+    r->last_tick = tick;
+}
+
+void replay_record_checkpoint(galton_replay_t *r, uint32_t ticks) {
+    r->header.ticks = ticks;
+    r->header.state_hash = r->hash;
+}
+
+/************ Formato serializado (little-endian) ************/
+static uint8_t *put_u32(uint8_t *p, uint32_t v) {
+    for (int i = 0; i < 4; i++) *p++ = (uint8_t)(v >> (8 * i));
+    return p;
+}
+
+static uint8_t *put_u64(uint8_t *p, uint64_t v) {
+    return put_u32(put_u32(p, (uint32_t)v), (uint32_t)(v >> 32));
+}
+
+static uint32_t get_u32(const uint8_t *p) {
+    return p[0] | (p[1] << 8) | (p[2] << 16) | ((uint32_t)p[3] << 24);
+}
+
+static uint64_t get_u64(const uint8_t *p) {
+    return get_u32(p) | ((uint64_t)get_u32(p + 4) << 32);
+}
+
+size_t replay_serialize(const galton_replay_t *r, uint8_t *out, size_t capacity) {
+    const replay_header_t *h = &r->header;
+    uint32_t bias_bits;
+
+    if (capacity < REPLAY_HEADER_BYTES + r->length) return 0;
+
+    memcpy(&bias_bits, &h->balance_bias, sizeof(bias_bits));
+    uint8_t *p = out;
+    memcpy(p, REPLAY_MAGIC, 4);
+    p = put_u64(p + 4, h->seed);
+    p = put_u32(p, h->ticks);
+    p = put_u64(p, h->state_hash);
+    p = put_u32(p, bias_bits);
+    p = put_u32(p, (uint32_t)h->balls_per_drop);
+    p = put_u32(p, (uint32_t)h->sim_mode);
+    p = put_u32(p, (uint32_t)h->sampler);
+    p = put_u32(p, (uint32_t)h->tick_ms);
+    *p++ = h->pin_rows;
+    *p++ = h->num_bins;
+    *p++ = h->fixed_point;
+    *p++ = h->truncated;
+    p = put_u32(p, h->capacity);
+    *p++ = h->pin_diameter;
+    *p++ = h->pin_spacing_h;
+    *p++ = h->pin_spacing_v;
+    *p++ = h->bin_width;
+    p = put_u32(p, (uint32_t)r->length);
+    memcpy(p, r->events, r->length);
+    return REPLAY_HEADER_BYTES + r->length;
+}
+
+// Lê o próximo evento da reprodução (next_buttons = 0 quando acabam)
+static void replay_read_next(galton_replay_t *r) {
+    uint32_t delta = 0;
+    r->next_buttons = 0;
+
+    for (int shift = 0; r->cursor < r->length; shift += 7) {
+        uint8_t byte = r->events[r->cursor++];
+        delta |= (uint32_t)(byte & 0x7F) << shift;
+        if (!(byte & 0x80)) break;
+    }
+    if (r->cursor >= r->length) return; // Falta o byte dos botões
+
+    r->next_buttons = r->events[r->cursor++];
+    r->next_tick = r->last_tick + delta;
+    r->last_tick = r->next_tick;
+}
+
+bool replay_load(galton_replay_t *r, const uint8_t *data, size_t len) {
+    replay_header_t *h = &r->header;
+
+    if (len < REPLAY_HEADER_BYTES_V1) return false;
+    bool v1 = memcmp(data, REPLAY_MAGIC_V1, 4) == 0;
+    if (!v1 && memcmp(data, REPLAY_MAGIC, 4) != 0) return false;
+
+    size_t header_bytes = v1 ? REPLAY_HEADER_BYTES_V1 : REPLAY_HEADER_BYTES;
+    if (len < header_bytes) return false;
+    uint32_t events = get_u32(data + header_bytes - 4);
+    if (events > sizeof(r->events) || len < header_bytes + events) return false;
+
+    uint32_t bias_bits = get_u32(data + 24);
+    h->seed = get_u64(data + 4);
+    h->ticks = get_u32(data + 12);
+    h->state_hash = get_u64(data + 16);
+    memcpy(&h->balance_bias, &bias_bits, sizeof(bias_bits));
+    h->balls_per_drop = (int32_t)get_u32(data + 28);
+    h->sim_mode = (int32_t)get_u32(data + 32);
+    h->sampler = (int32_t)get_u32(data + 36);
+    h->tick_ms = (int32_t)get_u32(data + 40);
+    h->pin_rows = data[44];
+    h->num_bins = data[45];
+    h->fixed_point = data[46];
+    h->truncated = data[47];
+    h->capacity = get_u32(data + 48);
+    if (v1) { // Geometria da variante compilada
+        h->pin_diameter = BOARD_PIN_DIAMETER;
+        h->pin_spacing_h = BOARD_PIN_SPACING_H;
+        h->pin_spacing_v = BOARD_PIN_SPACING_V;
+        h->bin_width = BOARD_BIN_WIDTH;
+    } else {
+        h->pin_diameter = data[52];
+        h->pin_spacing_h = data[53];
+        h->pin_spacing_v = data[54];
+        h->bin_width = data[55];
+    }
+
+    memcpy(r->events, data + header_bytes, events);
+    r->length = events;
+    r->cursor = 0;
+    r->last_tick = 0;
+    r->hash = FNV_OFFSET;
+    r->mode = REPLAY_PLAYING;
+    replay_read_next(r);
+    return true;
+}
+
+/************ Reprodução ************/
+const char *replay_incompatible(const galton_replay_t *r) {
+    const replay_header_t *h = &r->header;
+#ifdef GALTON_FIXED_POINT
+    const uint8_t fixed_point = 1;
+#else
+    const uint8_t fixed_point = 0;
+#endif
+
+    if (h->pin_rows < 1 || h->pin_rows > MAX_PIN_ROWS || h->num_bins < 1 || h->num_bins > MAX_BINS) {
+        return "tamanho de placa fora de MAX_PIN_ROWS/MAX_BINS";
+    }
+    if (h->fixed_point != fixed_point) return "física em float e em ponto fixo";
+    if (h->capacity != MAX_PARTICLES) return "MAX_PARTICLES diferente";
+    if (h->truncated) return "gravação truncada (buffer de eventos cheio)";
+    return NULL;
+}
+
+void replay_apply_header(const galton_replay_t *r) {
+    const replay_header_t *h = &r->header;
+
+    RNG_SEED = h->seed;
+    BALANCE_BIAS = h->balance_bias;
+    BALLS_PER_DROP = h->balls_per_drop;
+    SIM_MODE = h->sim_mode;
+    BINOMIAL_SAMPLER = h->sampler;
+    TICK_DELAY_MS = h->tick_ms;
+    PIN_ROW_COUNT = h->pin_rows;
+    BIN_COUNT = h->num_bins;
+    PIN_DIAMETER = h->pin_diameter;
+    PIN_SPACING_HORIZONTAL = h->pin_spacing_h;
+    PIN_SPACING_VERTICAL = h->pin_spacing_v;
+    BIN_WIDTH = h->bin_width;
+}
+
+int replay_buttons_at(galton_replay_t *r, uint32_t tick) {
+    if (r->next_buttons == 0 || tick != r->next_tick) return 0;
+
+    int buttons = r->next_buttons;
+    replay_read_next(r);
+    return buttons;
+}
+
+/************ Hash do estado ************/
+static uint64_t fnv1a(uint64_t hash, const void *data, size_t len) {
+    const uint8_t *p = data;
+    for (size_t i = 0; i < len; i++) hash = (hash ^ p[i]) * FNV_PRIME;
+    return hash;
+}
+
+uint64_t replay_hash_board(const galton_board_t *b, uint64_t hash) {
+    const ParticlePool *pool = &b->particles;
+    size_t bytes = (size_t)pool->count * sizeof(phys_t);
+
+    hash = fnv1a(hash, pool->x, bytes);
+    hash = fnv1a(hash, pool->y, bytes);
+    hash = fnv1a(hash, pool->vx, bytes);
+    hash = fnv1a(hash, pool->vy, bytes);
+    hash = fnv1a(hash, b->hist.bins, sizeof(b->hist.bins[0]) * b->hist.num_bins);
+    hash = fnv1a(hash, b->rng.s, sizeof(b->rng.s));
+    hash = fnv1a(hash, &b->total_particles, sizeof(b->total_particles));
+    return fnv1a(hash, &b->sim_time_ms, sizeof(b->sim_time_ms));
+}
+
+void replay_step(galton_replay_t *r, const galton_board_t *b) {
+    r->hash = replay_hash_board(b, r->hash);
+}
+
+/************ Impressão pela USB (firmware) ************/
+#if GALTON_REPLAY && !defined(GALTON_HOST)
+static absolute_time_t replay_last_report;
+static size_t replay_reported_length;
+
+void replay_poll(void) {
+    static uint8_t buf[REPLAY_MAX_BYTES];
+    absolute_time_t now = get_absolute_time();
+
+    if (replay.mode != REPLAY_RECORDING) return;
+    if (replay.length == replay_reported_length &&
+        absolute_time_diff_us(replay_last_report, now) < REPLAY_REPORT_MS * 1000ll) return;
+
+    replay_record_checkpoint(&replay, main_board.steps);
+    size_t len = replay_serialize(&replay, buf, sizeof(buf));
+    printf("replay=");
+    for (size_t i = 0; i < len; i++) printf("%02x", buf[i]);
+    printf("\n");
+
+    replay_reported_length = replay.length;
+    replay_last_report = now;
+}
+#endif
@@ -0,0 +1,98 @@
+// Gerador pseudoaleatório xoshiro128++ com fluxos independentes
+
+#include "inc/galton_rng.h"
+
+/************ Semeadura ************/
+// SplitMix64: espalha a semente para que estados vizinhos não fiquem correlacionados
+static uint64_t splitmix64(uint64_t *x) {
+    uint64_t z = (*x += 0x9E3779B97F4A7C15ull);
+    z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ull;
+    z = (z ^ (z >> 27)) * 0x94D049BB133111EBull;
+    return z ^ (z >> 31);
+}
+
+void rng_seed(galton_rng_t *rng, uint64_t seed, uint32_t stream) {
+    // O número do fluxo é misturado à semente antes do SplitMix64,
+    // então (semente, fluxo) diferentes geram estados independentes
+    uint64_t x = seed ^ ((uint64_t)stream * 0xD1342543DE82EF95ull);
+    uint64_t a = splitmix64(&x);
+    uint64_t b = splitmix64(&x);
+
+    rng->s[0] = (uint32_t)a;
+    rng->s[1] = (uint32_t)(a >> 32);
+    rng->s[2] = (uint32_t)b;
+    rng->s[3] = (uint32_t)(b >> 32);
+
+    // Estado todo zero é inválido para o xoshiro
+    if ((rng->s[0] | rng->s[1] | rng->s[2] | rng->s[3]) == 0) rng->s[0] = 1;
+}
+
+void rng_jump(galton_rng_t *rng) {
+    static const uint32_t jump[] = { 0x8764000b, 0xf542d2d3, 0x6fa035c3, 0x77f2db5b };
+    uint32_t s0 = 0, s1 = 0, s2 = 0, s3 = 0;
+
+    for (int i = 0; i < 4; i++) {
+        for (int b = 0; b < 32; b++) {
+            if (jump[i] & (1u << b)) {
+                s0 ^= rng->s[0];
+                s1 ^= rng->s[1];
+                s2 ^= rng->s[2];
+                s3 ^= rng->s[3];
+            }
+            rng_next(rng);
+        }
+    }
+
+    rng->s[0] = s0;
+    rng->s[1] = s1;
+    rng->s[2] = s2;
+    rng->s[3] = s3;
+}
+
+/************ Limiar de probabilidade ************/
+uint32_t rng_threshold_from_probability(float p) {
+    if (p <= 0.0f) return 0;
+    if (p >= 1.0f) return UINT32_MAX; // 1 - 2^-32: "sempre", na prática
+    return (uint32_t)((double)p * 4294967296.0);
+}
+
+/************ Decisões em lote ************/
+int rng_fill_decisions(galton_rng_t *rng, uint32_t threshold, uint32_t *words, int n) {
+    int count = 0;
+
+    for (int w = 0; n > 0; w++) {
+        int bits = n < 32 ? n : 32;
+        uint32_t word = 0;
+
+        if (threshold == RNG_THRESHOLD_HALF) {
+            // 50%: cada bit de um número aleatório já é uma decisão
+            word = rng_next(rng);
+            if (bits < 32) word &= (1u << bits) - 1;
+        } else {
+            for (int b = 0; b < bits; b++) {
+                word |= (uint32_t)rng_decision(rng, threshold) << b;
+            }
+        }
+
+        words[w] = word;
+        count += __builtin_popcount(word);
+        n -= bits;
+    }
+
+    return count;
+}
+
+int rng_count_decisions(galton_rng_t *rng, uint32_t threshold, int n) {
+    int count = 0;
+
+    if (threshold == RNG_THRESHOLD_HALF) {
+        for (; n >= 32; n -= 32) count += __builtin_popcount(rng_next(rng));
+        if (n > 0) count += __builtin_popcount(rng_next(rng) & ((1u << n) - 1));
+        return count;
+    }
+
+    for (int i = 0; i < n; i++) {
+        count += rng_decision(rng, threshold);
+    }
+    return count;
+}
@@ -0,0 +1,114 @@
+// Escalonador de passo fixo da simulação
+
+#include "inc/galton_scheduler.h"
+#include "inc/galton_config.h"
+
+// Verdadeiro se o prazo 'deadline' já chegou em 'now'
+static inline bool deadline_reached(absolute_time_t deadline, absolute_time_t now) {
+    return absolute_time_diff_us(deadline, now) >= 0;
+}
+
+void scheduler_init(galton_scheduler_t *s, uint32_t step_ms, int target_fps) {
+    absolute_time_t now = get_absolute_time();
+
+    s->step_us = step_ms * 1000;
+    s->frame_us = 1000000 / (uint32_t)(target_fps > 0 ? target_fps : 1);
+    s->next_step = now;  // O primeiro passo e o primeiro quadro saem imediatamente
+    s->next_frame = now;
+    s->steps = 0;
+    s->frames = 0;
+    s->frames_skipped = 0;
+    s->steps_dropped = 0;
+    s->steps_idle = 0;
+    s->idle_sleeps = 0;
+    s->pending = false;
+    s->idle = NULL;
+    s->skip = NULL;
+    s->wake = NULL;
+}
+
+void scheduler_set_idle(galton_scheduler_t *s, scheduler_idle_fn idle, scheduler_skip_fn skip, scheduler_wake_fn wake) {
+    s->idle = idle;
+    s->skip = skip;
+    s->wake = wake;
+}
+
+// Modo ocioso: dorme até o primeiro passo com trabalho (ou um evento) e pula os passos vencidos.
+// Retorna false se o próximo passo tem trabalho ou ainda há quadro por desenhar.
+static bool scheduler_idle(galton_scheduler_t *s, absolute_time_t now) {
+    if (!s->idle || s->pending || !deadline_reached(s->next_step, now)) return false;
+
+    uint32_t idle = s->idle();
+    if (idle == 0) return false;
+
+    // O passo next_step + idle * step_us é o primeiro com trabalho: dorme até ele, não até o próximo tick
+    absolute_time_t work = delayed_by_us(s->next_step, (uint64_t)idle * s->step_us);
+    s->idle_sleeps++;
+    while (!s->wake || !s->wake()) {
+        if (best_effort_wfe_or_timeout(work)) break; // Acorda com qualquer interrupção (ex.: borda de botão)
+    }
+
+    // Pula os passos ociosos cujo prazo já passou; os demais seguem o caminho normal
+    absolute_time_t after = get_absolute_time();
+    uint64_t due = (uint64_t)absolute_time_diff_us(s->next_step, after) / s->step_us + 1;
+    if (due > idle) due = idle;
+    s->skip((uint32_t)due);
+    s->steps += (uint32_t)due;
+    s->steps_idle += (uint32_t)due;
+    s->next_step = delayed_by_us(s->next_step, due * s->step_us);
+    if (deadline_reached(s->next_frame, after)) {
+        uint32_t missed = (uint32_t)(absolute_time_diff_us(s->next_frame, after) / s->frame_us) + 1;
+        s->next_frame = delayed_by_us(s->next_frame, (uint64_t)missed * s->frame_us); // Tela parada: nada a desenhar
+    }
+    return true;
+}
+
+bool scheduler_run_once(galton_scheduler_t *s, scheduler_fn step, scheduler_fn render) {
+    absolute_time_t now = get_absolute_time();
+    bool rendered = false;
+
+    // --- MODO OCIOSO: NADA MUDA ATÉ O PRÓXIMO LANÇAMENTO ---
+    if (scheduler_idle(s, now)) return false;
+
+    // --- PASSOS DE FÍSICA ATRASADOS ---
+    int n = 0;
+    while (deadline_reached(s->next_step, now) && n < MAX_STEPS_PER_FRAME) {
+        step();
+        s->steps++;
+        s->next_step = delayed_by_us(s->next_step, s->step_us);
+        s->pending = true;
+        n++;
+    }
+
+    // Atraso grande demais para recuperar: abandona-o em vez de entrar em espiral
+    if (deadline_reached(s->next_step, now)) {
+        uint64_t lag = (uint64_t)absolute_time_diff_us(s->next_step, now);
+        s->steps_dropped += (uint32_t)(lag / s->step_us) + 1;
+        s->next_step = delayed_by_us(now, s->step_us);
+    }
+
+    // --- QUADRO ---
+    if (deadline_reached(s->next_frame, now)) {
+        if (s->pending) { // Sem passo novo não há o que redesenhar
+            render();
+            s->frames++;
+            s->pending = false;
+            rendered = true;
+        }
+        s->next_frame = delayed_by_us(s->next_frame, s->frame_us);
+
+        // Se o desenho estourou o período, pula os quadros perdidos mantendo a cadência
+        absolute_time_t after = get_absolute_time();
+        if (deadline_reached(s->next_frame, after)) {
+            uint32_t missed = (uint32_t)(absolute_time_diff_us(s->next_frame, after) / s->frame_us) + 1;
+            s->frames_skipped += missed;
+            s->next_frame = delayed_by_us(s->next_frame, (uint64_t)missed * s->frame_us);
+        }
+    }
+
+    // --- ESPERA ATÉ O PRÓXIMO PRAZO ---
+    absolute_time_t wake = absolute_time_diff_us(s->next_step, s->next_frame) < 0 ? s->next_frame : s->next_step;
+    sleep_until(wake);
+
+    return rendered;
+}
@@ -1,190 +1,572 @@
 // Lógica da simulação
 
 #include "inc/galton_config.h"  // Inclusão do cabeçalho com definições e constantes do projeto
+#include "inc/galton_board.h"   // Estado de cada placa (a da tela é main_board)
+#include "inc/galton_profile.h" // Tempos de update_particles() e das colisões
+#include "inc/galton_stats.h"   // Contagem sem perdas e estatísticas por bola
+#include "inc/galton_binomial.h" // Sorteio binomial bit a bit no modo rápido
+#include "inc/galton_replay.h"   // Botões gravados ou reproduzidos e hash do estado
+#include "inc/galton_geometry.h" // Tabelas da variante compilada (valores iniciais da geometria)
+#include "inc/galton_input.h"    // Fila de bordas dos botões e gestos
 
 /************ Variáveis globais de configuração ************/
 float GRAVITY = 0.2f;                   // Aceleração gravitacional das partículas
 float BOUNCINESS = 0.3f;               // Coeficiente de restituição (quanto a bola quica após colisão)
-int PIN_DIAMETER = 3;                  // Diâmetro dos pinos na simulação
-int PIN_SPACING_HORIZONTAL = 9;        // Espaçamento horizontal entre pinos
-int PIN_SPACING_VERTICAL = 7;          // Espaçamento vertical entre pinos
-int CHUTE_WIDTH = 0;                   // Largura do funil inicial por onde as bolas caem
-int BIN_WIDTH = 9;                     // Largura de cada bin do histograma
-int WALL_OFFSET = 0;                   // Compensação horizontal das paredes
-int MAX_HISTOGRAM_HEIGHT = 13;         // Altura máxima (normalizada) das barras do histograma
-int TICK_DELAY_MS = 35;                // Delay entre atualizações da simulação (em ms)
+int PIN_ROW_COUNT = PIN_ROWS;          // Linhas de pinos da placa da tela
+int BIN_COUNT = NUM_BINS;              // Caixas coletoras da placa da tela
+int PIN_DIAMETER = BOARD_PIN_DIAMETER; // Diâmetro dos pinos na simulação
+int PIN_SPACING_HORIZONTAL = BOARD_PIN_SPACING_H; // Espaçamento horizontal entre pinos
+int PIN_SPACING_VERTICAL = BOARD_PIN_SPACING_V; // Espaçamento vertical entre pinos
+int CHUTE_WIDTH = BOARD_CHUTE_WIDTH; // Largura do funil inicial por onde as bolas caem
+int BIN_WIDTH = BOARD_BIN_WIDTH; // Largura de cada bin do histograma
+int WALL_OFFSET = BOARD_WALL_OFFSET; // Compensação horizontal das paredes
+int MAX_HISTOGRAM_HEIGHT = BOARD_MAX_HISTOGRAM_HEIGHT; // Altura máxima (normalizada) das barras do histograma
+int TICK_DELAY_MS = 35;                // Passo fixo da simulação (em ms)
+int TARGET_FPS = 30;                   // Taxa de quadros desejada no display
 float BALANCE_BIAS = 5.0f;             // Tendência de desvio ao colidir com pinos (0 a 10)
 int BALLS_PER_DROP = 1;                // Número de bolas lançadas a cada vez
+int SIM_MODE = SIM_MODE_DEFAULT;       // Física completa ou sorteio binomial direto
+int BINOMIAL_SAMPLER = SAMPLER_SCALAR; // Uma decisão por número aleatório ou 256 por rodada
+uint64_t RNG_SEED = 0;                 // Semente explícita (0 = semente pelo relógio no setup)
+int HISTOGRAM_BASE_Y = BOARD_HISTOGRAM_BASE_Y; // Posição vertical da base do histograma
 
 /************ Estruturas e buffers ************/
 uint8_t oled_buffer[SSD1306_BUFFER_SIZE];  // Buffer de imagem do display OLED
 struct render_area oled_area = {0, OLED_WIDTH - 1, 0, ssd1306_n_pages - 1}; // Área de renderização do OLED
 
-Particle particles[MAX_PARTICLES];         // Vetor de partículas (bolas)
-Pin pins[PIN_ROWS * (PIN_ROWS + 1) / 2];   // Vetor de pinos (dispostos em pirâmide)
-uint16_t histogram[NUM_BINS] = {0};        // Vetor com a contagem de partículas em cada bin
-uint32_t total_particles = 0;              // Contador total de partículas lançadas
+galton_board_t main_board;                          // Placa exibida na tela
+static phys_t main_particle_storage[4 * MAX_PARTICLES]; // x, y, vx, vy das bolas da placa da tela
+
+/************ Parâmetros e montagem de uma placa ************/
+void board_params_from_globals(galton_params_t *p) {
+    p->gravity = GRAVITY;
+    p->bounciness = BOUNCINESS;
+    p->balance_bias = BALANCE_BIAS;
+    p->balls_per_drop = BALLS_PER_DROP;
+    p->sim_mode = SIM_MODE;
+    p->sampler = BINOMIAL_SAMPLER;
+    p->tick_ms = TICK_DELAY_MS;
+    p->pin_rows = PIN_ROW_COUNT;
+    p->num_bins = BIN_COUNT;
+    p->pin_diameter = PIN_DIAMETER;
+    p->pin_spacing_h = PIN_SPACING_HORIZONTAL;
+    p->pin_spacing_v = PIN_SPACING_VERTICAL;
+    p->chute_width = CHUTE_WIDTH;
+    p->bin_width = BIN_WIDTH;
+    p->wall_offset = WALL_OFFSET;
+    p->histogram_base_y = HISTOGRAM_BASE_Y;
+}
+
+// Viés em limiar de 32 bits, limitado a 5%..95% como no limiar inteiro original
+static void board_update_bias(galton_board_t *b) {
+    float p = b->params.balance_bias / 10.0f; // 0 = sempre esquerda, 10 = sempre direita
+
+    if (p < 0.05f) p = 0.05f;
+    if (p > 0.95f) p = 0.95f;
+
+    b->bias_threshold = rng_threshold_from_probability(p);
+    b->bias_applied = b->params.balance_bias;
+    histogram_set_reference(&b->hist, b->bias_threshold); // Qui-quadrado passa a comparar com a binomial do novo viés
+}
+
+// Converte os parâmetros em float para o tipo da física uma vez, e não a cada partícula
+static void board_update_coefficients(galton_board_t *b) {
+    b->gravity_step = PHYS_FROM_FLOAT(b->params.gravity);
+    b->bounce_coef = PHYS_COEF_FROM_FLOAT(b->params.bounciness);
+    b->pin_kick = PHYS_FROM_FLOAT(b->params.pin_spacing_h * 0.06f);
+}
+
+// Geometria igual à da variante compilada: as tabelas de board_static valem para a placa
+static bool board_matches_static_geometry(const galton_params_t *p) {
+    return p->pin_rows == PIN_ROWS && p->num_bins == NUM_BINS &&
+           p->pin_diameter == BOARD_PIN_DIAMETER && p->pin_spacing_h == BOARD_PIN_SPACING_H &&
+           p->pin_spacing_v == BOARD_PIN_SPACING_V && p->chute_width == BOARD_CHUTE_WIDTH &&
+           p->bin_width == BOARD_BIN_WIDTH && p->wall_offset == BOARD_WALL_OFFSET &&
+           p->histogram_base_y == BOARD_HISTOGRAM_BASE_Y;
+}
+
+bool board_params_valid(const galton_params_t *p) {
+    if (p->pin_rows < 1 || p->pin_rows > MAX_PIN_ROWS) return false;
+    if (p->num_bins < 1 || p->num_bins > MAX_BINS) return false;
+    if (p->pin_spacing_h < 1 || p->pin_spacing_v < 1 || p->bin_width < 3) return false; // Barra tem bin_width - 2 px
+
+    // Paredes dentro da tela e última linha de pinos acima da base do histograma
+    int wall_left = (OLED_WIDTH - p->num_bins * p->bin_width) / 2 - p->wall_offset;
+    int wall_right = wall_left + p->num_bins * p->bin_width + 2 * p->wall_offset;
+    if (wall_left < 0 || wall_right >= OLED_WIDTH) return false;
+    if (PIN_TOP_Y + (p->pin_rows - 1) * p->pin_spacing_v >= p->histogram_base_y) return false;
+
+    // Última linha de pinos (a mais larga) entre as paredes, centrada como em board_initialize_pins
+    int last_left = OLED_WIDTH / 2 - (p->pin_rows - 1) * p->pin_spacing_h / 2;
+    int last_right = last_left + (p->pin_rows - 1) * p->pin_spacing_h;
+    return last_left >= wall_left && last_right <= wall_right;
+}
+
+// Paredes e canaleta da geometria de b->params
+static void board_calculate_geometry(galton_board_t *b) {
+    const galton_params_t *params = &b->params;
+
+    b->static_geometry = board_matches_static_geometry(params);
+    b->num_pins = params->pin_rows * (params->pin_rows + 1) / 2;
+
+    if (b->static_geometry) { // Já calculadas na compilação
+        b->wall_left = board_static.wall_left;
+        b->wall_right = board_static.wall_right;
+        b->chute_left = board_static.chute_left;
+        b->chute_right = board_static.chute_right;
+        return;
+    }
+
+    // -------- GEOMETRIA DA GALTON BOARD --------
+    int total_width = params->num_bins * params->bin_width; // Largura total das canaletas (bins)
+    b->wall_left = (OLED_WIDTH - total_width) / 2 - params->wall_offset; // Parede esquerda
+    b->wall_right = b->wall_left + total_width + 2 * params->wall_offset; // Parede direita
+    b->chute_left = OLED_WIDTH / 2 - params->chute_width / 2; // Canaleta central (entrada de bolas)
+    b->chute_right = OLED_WIDTH / 2 + params->chute_width / 2;
+}
+
+// Pinos em disposição triangular, linha a linha
+static void board_initialize_pins(galton_board_t *b) {
+    const galton_params_t *params = &b->params;
+
+    if (b->static_geometry) { // Variante compilada: cópia da flash
+        memcpy(b->pins, board_static.pins, sizeof(board_static.pins));
+        return;
+    }
+
+    // -------- POSIÇÃO DOS PINOS --------
+    int idx = 0; // Índice global dos pinos
+    for (int row = 0; row < params->pin_rows; row++) { // Para cada linha de pinos
+        int pins_in_row = row + 1; // Quantidade de pinos na linha (formato triangular)
+        int start_x = OLED_WIDTH / 2 - (pins_in_row - 1) * params->pin_spacing_h / 2; // Centraliza linha
+        for (int col = 0; col < pins_in_row; col++) { // Para cada pino da linha
+            b->pins[idx].x = start_x + col * params->pin_spacing_h; // Calcula posição X do pino
+            b->pins[idx].y = PIN_TOP_Y + row * params->pin_spacing_v; // Calcula posição Y do pino
+            idx++;
+        }
+    }
+}
+
+// Copia só a parte geométrica dos parâmetros
+static void board_copy_geometry_params(galton_params_t *dst, const galton_params_t *src) {
+    dst->pin_rows = src->pin_rows;
+    dst->num_bins = src->num_bins;
+    dst->pin_diameter = src->pin_diameter;
+    dst->pin_spacing_h = src->pin_spacing_h;
+    dst->pin_spacing_v = src->pin_spacing_v;
+    dst->chute_width = src->chute_width;
+    dst->bin_width = src->bin_width;
+    dst->wall_offset = src->wall_offset;
+    dst->histogram_base_y = src->histogram_base_y;
+}
 
-absolute_time_t last_particle_time;        // Tempo da última partícula lançada
-absolute_time_t last_button_time;          // Tempo da última leitura dos botões (para debounce)
+// Recomeça a placa após trocar a geometria: as bolas em voo e as contagens eram de outra placa
+static void board_restart(galton_board_t *b) {
+    b->geometry_version++;
+    b->particles.count = 0;
+    histogram_configure(&b->hist, b->params.pin_rows, b->params.num_bins);
+    b->total_particles = 0;
+    b->sim_time_ms = 0;
+    b->last_particle_time = 0;
+    b->steps = 0;
+
+    board_update_coefficients(b); // O chute lateral depende do espaçamento
+    board_update_bias(b);         // Binomial de referência com o novo número de linhas
+}
+
+void board_set_geometry(galton_board_t *b, const galton_params_t *params) {
+    board_copy_geometry_params(&b->params, params);
+    board_calculate_geometry(b);
+    board_initialize_pins(b);
+    board_restart(b);
+}
+
+void board_init(galton_board_t *b, const galton_params_t *params, phys_t *storage, int capacity,
+                uint64_t seed, uint32_t stream) {
+    b->params = *params;
+    b->geometry_version = 0;
+
+    // -------- PARTÍCULAS, HISTOGRAMA E ALEATORIEDADE --------
+    b->particles.x = storage;
+    b->particles.y = storage + capacity;
+    b->particles.vx = storage + 2 * capacity;
+    b->particles.vy = storage + 3 * capacity;
+    b->particles.capacity = capacity;
+    b->telemetry = NULL;
+    board_reseed(b, seed, stream);
+
+    board_set_geometry(b, params); // Paredes, pinos, histograma zerado e coeficientes
+}
+
+void board_reseed(galton_board_t *b, uint64_t seed, uint32_t stream) {
+    rng_seed(&b->rng, seed, stream);
+    rng_lanes_seed(&b->lanes, seed, stream);
+}
+
+void init_main_board(uint64_t seed) {
+    galton_params_t params;
+    board_params_from_globals(&params);
+    board_init(&main_board, &params, main_particle_storage, MAX_PARTICLES, seed, 0); // Fluxo 0 da simulação
+    if (GALTON_TELEMETRY) main_board.telemetry = &telemetry_ring; // Pousos da tela vão pela USB
+}
+
+/************ Tamanho da placa da tela em tempo de execução ************/
+// Tamanhos usados no laboratório, trocados em ciclo segurando A e B (o primeiro é a variante compilada)
+static const struct {
+    int rows, bins, spacing_h, spacing_v, bin_width;
+} board_presets[] = {
+    {PIN_ROWS, NUM_BINS, BOARD_PIN_SPACING_H, BOARD_PIN_SPACING_V, BOARD_BIN_WIDTH},
+    {3, 4, 12, 10, 12},
+    {7, 8, 9, 5, 9},
+    {9, 10, 8, 4, 8},
+};
+#define NUM_BOARD_PRESETS ((int)(sizeof(board_presets) / sizeof(board_presets[0])))
+static int board_preset; // Último tamanho escolhido pelo acorde
+
+void calculate_geometry() {
+    galton_params_t params;
+    board_params_from_globals(&params);
+    board_copy_geometry_params(&main_board.params, &params);
+    board_calculate_geometry(&main_board);
+}
+
+void initialize_pins() {
+    board_initialize_pins(&main_board);
+}
 
-/************ Limites e controle de posição ************/
-int WALL_LEFT, WALL_RIGHT;                 // Coordenadas das paredes esquerda e direita
-int HISTOGRAM_BASE_Y = OLED_HEIGHT - 2;   // Posição vertical da base do histograma
-int CHUTE_LEFT, CHUTE_RIGHT;              // Limites do funil inicial de lançamento
+bool reconfigure_board(int rows, int bins, int spacing_h, int spacing_v, int bin_width) {
+    galton_params_t params;
+
+    if (replay.mode == REPLAY_PLAYING) return false; // A gravação reproduzida tem tamanho fixo
+    board_params_from_globals(&params);
+    params.pin_rows = rows;
+    params.num_bins = bins;
+    params.pin_spacing_h = spacing_h;
+    params.pin_spacing_v = spacing_v;
+    params.bin_width = bin_width;
+    if (!board_params_valid(&params)) return false;
+
+    PIN_ROW_COUNT = rows;
+    BIN_COUNT = bins;
+    PIN_SPACING_HORIZONTAL = spacing_h;
+    PIN_SPACING_VERTICAL = spacing_v;
+    BIN_WIDTH = bin_width;
+
+    // Reconstrução nos vetores fixos de main_board, sem alocar
+    calculate_geometry();
+    initialize_pins();
+    board_restart(&main_board);
+
+    // Execução nova com semente tirada do próprio gerador: a gravação recomeça daqui
+    uint64_t seed = ((uint64_t)rng_next(&main_board.rng) << 32) | rng_next(&main_board.rng);
+    board_reseed(&main_board, seed, 0);
+    if (replay.mode == REPLAY_RECORDING) replay_record_begin(&replay, seed);
+    return true;
+}
+
+void board_update_params(galton_board_t *b, const galton_params_t *params) {
+    b->params.gravity = params->gravity;
+    b->params.bounciness = params->bounciness;
+    b->params.balance_bias = params->balance_bias;
+    b->params.balls_per_drop = params->balls_per_drop;
+    b->params.sim_mode = params->sim_mode;
+    b->params.sampler = params->sampler;
+    b->params.tick_ms = params->tick_ms;
+
+    board_update_coefficients(b);
+    if (b->params.balance_bias != b->bias_applied) board_update_bias(b); // Referência do qui-quadrado só muda com o viés
+}
 
 /************ Inicialização de uma partícula ************/
-void init_particle(int index) {
+static void board_init_particle(galton_board_t *b, int index) {
+    ParticlePool *pool = &b->particles;
+    int chute_width = b->params.chute_width;
+
     // Inicializa a partícula no centro com leve variação aleatória dentro do funil
-    particles[index] = (Particle){
-        .x = OLED_WIDTH / 2 + (rand() % CHUTE_WIDTH - CHUTE_WIDTH/2),
-        .y = 5,        // Posição inicial no topo
-        .vx = 0,       // Velocidade horizontal
-        .vy = 0,       // Velocidade vertical
-        .active = true,
-        .bin_position = -1
-    };
+    int x = OLED_WIDTH / 2 + (chute_width > 0 ? (int)rng_below(&b->rng, chute_width) - chute_width/2 : 0);
 
     // Garante que a partícula fique dentro dos limites do funil
-    if (particles[index].x < CHUTE_LEFT) particles[index].x = CHUTE_LEFT;
-    if (particles[index].x > CHUTE_RIGHT) particles[index].x = CHUTE_RIGHT;
+    if (x < b->chute_left) x = b->chute_left;
+    if (x > b->chute_right) x = b->chute_right;
+
+    pool->x[index] = PHYS_FROM_INT(x);
+    pool->y[index] = PHYS_FROM_INT(5);   // Posição inicial no topo
+    pool->vx[index] = 0;  // Velocidade horizontal
+    pool->vy[index] = 0;  // Velocidade vertical
 }
 
-/************ Leitura e ação dos botões A e B ************/
-void check_buttons() {
-    absolute_time_t now = get_absolute_time();
-    int64_t time_since_last = absolute_time_diff_us(last_button_time, now) / 1000;
+/************ Alocação O(1) no conjunto de partículas ************/
+int board_spawn_particle(galton_board_t *b) {
+    if (b->particles.count >= b->particles.capacity) return -1; // Conjunto cheio
 
-    if (time_since_last < DEBOUNCE_MS) return; // Ignora leitura se ainda dentro do tempo de debounce
+    int index = b->particles.count++; // Sempre ocupa a primeira posição livre, no fim
+    board_init_particle(b, index);
+    return index;
+}
+
+void board_despawn_particle(galton_board_t *b, int index) {
+    ParticlePool *pool = &b->particles;
+    int last = --pool->count;
+
+    // Move a última partícula viva para o lugar vago, mantendo [0, count) compacto
+    pool->x[index] = pool->x[last];
+    pool->y[index] = pool->y[last];
+    pool->vx[index] = pool->vx[last];
+    pool->vy[index] = pool->vy[last];
+}
 
+/************ Leitura e ação dos botões A e B ************/
+static void apply_buttons(int buttons) {
     // Botão A: altera quantidade de bolas lançadas por ciclo (1 a 5)
-    if (!gpio_get(BUTTON_A_PIN)) {
+    if (buttons & REPLAY_BUTTON_A) {
         BALLS_PER_DROP++;
         if (BALLS_PER_DROP > 5) BALLS_PER_DROP = 1;
-        last_button_time = now;
     }
 
-    // Botão B: altera viés de balanceamento (tendência para a direita)
-    if (!gpio_get(BUTTON_B_PIN)) {
+    // Botão B: altera viés de balanceamento (tendência para a direita); aplicado à placa no mesmo tick
+    if (buttons & REPLAY_BUTTON_B) {
         BALANCE_BIAS += 1.0f;
         if (BALANCE_BIAS > 10.0f) BALANCE_BIAS = 0.0f;
-        last_button_time = now;
     }
+
+    // A segurado: alterna entre a física completa e o modo binomial rápido
+    if (buttons & REPLAY_BUTTON_LONG_A) {
+        SIM_MODE = SIM_MODE == SIM_MODE_PHYSICS ? SIM_MODE_FAST_BINOMIAL : SIM_MODE_PHYSICS;
+    }
+
+    // B segurado: volta ao viés neutro
+    if (buttons & REPLAY_BUTTON_LONG_B) BALANCE_BIAS = 5.0f;
+}
+
+// A e B segurados: próximo tamanho da lista de predefinições
+static void next_board_preset(void) {
+    board_preset = (board_preset + 1) % NUM_BOARD_PRESETS;
+    reconfigure_board(board_presets[board_preset].rows, board_presets[board_preset].bins,
+                      board_presets[board_preset].spacing_h, board_presets[board_preset].spacing_v,
+                      board_presets[board_preset].bin_width);
 }
 
-/************ Sorteio com viés ************/
-bool random_decision_with_bias() {
-    int rand_val = rand() % 100;
-    int threshold = (int)(BALANCE_BIAS * 10);
+void check_buttons() {
+    int buttons;
+
+    // Reprodução: os botões vêm da gravação, no mesmo tick em que foram pressionados
+    if (replay.mode == REPLAY_PLAYING) {
+        while ((buttons = replay_buttons_at(&replay, main_board.steps)) != 0) apply_buttons(buttons);
+        return;
+    }
 
-    // Limita o viés para manter valores válidos
-    if (threshold < 5) threshold = 5;
-    if (threshold > 95) threshold = 95;
+    if (!input_pending()) return; // Nenhuma borda na fila e nenhum botão segurado
 
-    return (rand_val < threshold);  // Retorna verdadeiro se dentro do limiar
+    uint32_t now = time_us_32();
+    while ((buttons = input_next_gesture(now)) != 0) {
+        if (buttons & INPUT_CHORD_HOLD) {
+            next_board_preset(); // Recomeça a placa (e a gravação): não vai para os eventos
+            continue;
+        }
+        if (replay.mode == REPLAY_RECORDING) replay_record_buttons(&replay, main_board.steps, buttons);
+        apply_buttons(buttons);
+    }
 }
 
 /************ Checagem de colisão com os pinos ************/
-void check_pin_collisions(int idx) {
-    Particle *p = &particles[idx];
-
-    for (int i = 0; i < (PIN_ROWS * (PIN_ROWS + 1) / 2); i++) {
-        float dx = p->x - pins[i].x;
-        float dy = p->y - pins[i].y;
-        float distance = sqrtf(dx*dx + dy*dy);
-
-        // Se houver colisão com um pino
-        if (distance < (PIN_DIAMETER + BALL_DIAMETER)/2) {
-            if (random_decision_with_bias()) {
-                p->vx = PIN_SPACING_HORIZONTAL * 0.06f;   // Vai para a direita
-            } else {
-                p->vx = -PIN_SPACING_HORIZONTAL * 0.06f;  // Vai para a esquerda
-            }
-            p->vy = -p->vy * BOUNCINESS;  // Rebote vertical com perda de energia
-            break;
+// Intervalo [lo, hi] de posições k*spacing (0 <= k < count) a até 'radius' de 'rel'
+static inline bool lattice_range(int rel, int radius, int spacing, int count, int *lo, int *hi) {
+    if (rel + radius < 0) return false;
+    *lo = rel - radius <= 0 ? 0 : (rel - radius + spacing - 1) / spacing;
+    *hi = (rel + radius) / spacing;
+    if (*hi >= count) *hi = count - 1;
+    return *lo <= *hi;
+}
+
+// Índice do primeiro pino atingido em (x, y), ou -1, para qualquer geometria
+static int board_find_pin_hit(const galton_board_t *b, phys_t x, phys_t y) {
+    // Os pinos formam uma rede regular (ver board_init): a linha sai de y e a coluna de x,
+    // então só os pinos vizinhos da partícula são testados, qualquer que seja o número de linhas
+    const int radius = (b->params.pin_diameter + BALL_DIAMETER)/2;
+    int px = PHYS_TO_INT(x);
+    int py = PHYS_TO_INT(y);
+    int row_lo, row_hi;
+
+    if (!lattice_range(py - PIN_TOP_Y, radius, b->params.pin_spacing_v, b->params.pin_rows, &row_lo, &row_hi)) return -1;
+
+    for (int row = row_lo; row <= row_hi; row++) {
+        int first = row * (row + 1) / 2; // Índice do primeiro pino da linha (disposição triangular)
+        int col_lo, col_hi;
+
+        if (!lattice_range(px - b->pins[first].x, radius, b->params.pin_spacing_h, row + 1, &col_lo, &col_hi)) continue;
+
+        for (int i = first + col_lo; i <= first + col_hi; i++) {
+            phys_t dx = x - PHYS_FROM_INT(b->pins[i].x);
+            phys_t dy = y - PHYS_FROM_INT(b->pins[i].y);
+            if (phys_dist2_lt(dx, dy, radius)) return i; // Distância ao quadrado, sem raiz
         }
     }
+    return -1;
 }
 
-/************ Normaliza histograma para caber no display ************/
-void normalize_histogram() {
-    uint16_t max_val = 1;
+void board_check_pin_collisions(galton_board_t *b, int idx) {
+    ParticlePool *pool = &b->particles;
 
-    // Encontra o maior valor atual
-    for (int i = 0; i < NUM_BINS; i++) {
-        if (histogram[i] > max_val) {
-            max_val = histogram[i];
-        }
+    // Variante compilada: tabelas na flash, sem divisões; senão (ou fora da tela), a busca genérica
+    int pin = b->static_geometry ? board_static_pin_hit(pool->x[idx], pool->y[idx]) : BOARD_OUTSIDE_TABLES;
+    if (pin == BOARD_OUTSIDE_TABLES) pin = board_find_pin_hit(b, pool->x[idx], pool->y[idx]);
+    if (pin < 0) return;
+
+    if (rng_decision(&b->rng, b->bias_threshold)) {
+        pool->vx[idx] = b->pin_kick;   // Vai para a direita
+    } else {
+        pool->vx[idx] = -b->pin_kick;  // Vai para a esquerda
     }
+    pool->vy[idx] = -PHYS_SCALE(pool->vy[idx], b->bounce_coef);  // Rebote vertical com perda de energia
+}
 
-    // Se já está normalizado, não faz nada
-    if (max_val <= MAX_HISTOGRAM_HEIGHT) return;
+/************ Modo rápido: sorteio binomial direto ************/
+void board_drop_fast_binomial(galton_board_t *b, int count) {
+    // Cada bola decide esquerda/direita uma vez por linha, como ao bater nos pinos;
+    // o bin final é o número de decisões para a direita
+    const int rows = b->params.pin_rows, num_bins = b->params.num_bins;
+    uint32_t tally[MAX_BINS] = {0};
+    if (b->params.sampler != SAMPLER_SCALAR && rows <= BINOMIAL_MAX_ROWS) {
+        uint64_t counts[BINOMIAL_MAX_ROWS + 1] = {0};
+        binomial_sample(&b->lanes, b->bias_threshold, rows, (uint64_t)count, counts,
+                        b->params.sampler == SAMPLER_SIMD);
+        for (int k = 0; k <= rows; k++) tally[k < num_bins ? k : num_bins - 1] += (uint32_t)counts[k];
+    } else {
+        for (int n = 0; n < count; n++) {
+            int bin = rng_count_decisions(&b->rng, b->bias_threshold, rows);
+            if (bin >= num_bins) bin = num_bins - 1;
+            tally[bin]++;
+        }
+    }
 
-    // Normaliza cada bin proporcionalmente
-    for (int i = 0; i < NUM_BINS; i++) {
-        histogram[i] = (uint16_t)((float)histogram[i] / max_val * MAX_HISTOGRAM_HEIGHT);
+    // Estatísticas atualizadas uma vez por bin, não por bola
+    for (int bin = 0; bin < num_bins; bin++) {
+        histogram_add(&b->hist, bin, tally[bin]);
+        if (b->telemetry && tally[bin]) {
+            telemetry_emit(b->telemetry, b->steps, bin, tally[bin], b->params.balance_bias, b->params.balls_per_drop);
+        }
     }
+    b->total_particles += count;
 }
 
-/************ Atualiza movimento das partículas ************/
-void update_particles() {
-    check_buttons();  // Verifica botões antes de atualizar partículas
+/************ Um passo fixo de uma placa ************/
+void board_step(galton_board_t *b) {
+    PROFILE_TOTAL(collision_ticks); // Colisões somadas no tick: uma chamada é curta demais para medir sozinha
+    const galton_params_t *p = &b->params;
+    ParticlePool *pool = &b->particles;
 
-    absolute_time_t now = get_absolute_time();
-    int64_t time_since_last = absolute_time_diff_us(last_particle_time, now) / 1000;
+    // O lançamento segue o tempo simulado, então a física não depende da velocidade da tela
+    uint32_t time_since_last = b->sim_time_ms - b->last_particle_time;
 
     // Lança novas partículas se passou o tempo mínimo
     if (time_since_last > (1000 / PARTICLES_PER_SECOND)) {
-        for (int i = 0; i < BALLS_PER_DROP; i++) {
-            for (int j = 0; j < MAX_PARTICLES; j++) {
-                if (!particles[j].active) {
-                    init_particle(j);
-                    total_particles++;
-                    break;
-                }
-            }
+        for (int i = 0; i < p->balls_per_drop; i++) {
+            if (board_spawn_particle(b) < 0) break; // Sem espaço: tenta de novo no próximo lançamento
+            if (p->sim_mode == SIM_MODE_PHYSICS) b->total_particles++; // No modo rápido a bola é só animação
         }
-        last_particle_time = now;
+        b->last_particle_time = b->sim_time_ms;
     }
 
-    // Atualiza estado de cada partícula ativa
-    for (int i = 0; i < MAX_PARTICLES; i++) {
-        if (!particles[i].active) continue;
+    // Modo rápido: o histograma é alimentado diretamente, sem integrar cada bola
+    if (p->sim_mode == SIM_MODE_FAST_BINOMIAL) {
+        board_drop_fast_binomial(b, FAST_BALLS_PER_TICK * p->balls_per_drop);
+    }
+
+    const phys_t wall_min = PHYS_FROM_INT(b->wall_left + BALL_DIAMETER/2);
+    const phys_t wall_max = PHYS_FROM_INT(b->wall_right - BALL_DIAMETER/2);
+    const phys_t floor_y = PHYS_FROM_INT(p->histogram_base_y - BALL_DIAMETER);
 
+    // Atualiza somente as partículas vivas, compactadas em [0, count)
+    for (int i = 0; i < pool->count; ) {
         // Física básica: atualiza posição e velocidade
-        particles[i].vy += GRAVITY;
-        particles[i].x += particles[i].vx;
-        particles[i].y += particles[i].vy;
+        pool->vy[i] += b->gravity_step;
+        pool->x[i] += pool->vx[i];
+        pool->y[i] += pool->vy[i];
 
         // Colisão com parede esquerda
-        if (particles[i].x <= WALL_LEFT + BALL_DIAMETER/2) {
-            particles[i].x = WALL_LEFT + BALL_DIAMETER/2;
-            particles[i].vx = -particles[i].vx * BOUNCINESS;
+        if (pool->x[i] <= wall_min) {
+            pool->x[i] = wall_min;
+            pool->vx[i] = -PHYS_SCALE(pool->vx[i], b->bounce_coef);
         }
 
         // Colisão com parede direita
-        if (particles[i].x >= WALL_RIGHT - BALL_DIAMETER/2) {
-            particles[i].x = WALL_RIGHT - BALL_DIAMETER/2;
-            particles[i].vx = -particles[i].vx * BOUNCINESS;
+        if (pool->x[i] >= wall_max) {
+            pool->x[i] = wall_max;
+            pool->vx[i] = -PHYS_SCALE(pool->vx[i], b->bounce_coef);
         }
 
         // Verifica colisão com pinos
-        check_pin_collisions(i);
-
-        // Se chegou na base, desativa e conta no histograma
-        if (particles[i].y >= HISTOGRAM_BASE_Y - BALL_DIAMETER) {
-            particles[i].active = false;
-
-            int bin = (particles[i].x - WALL_LEFT - WALL_OFFSET) / BIN_WIDTH;
-            bin = bin < 0 ? 0 : (bin >= NUM_BINS ? NUM_BINS-1 : bin);
+        PROFILE_START(collision_start);
+        board_check_pin_collisions(b, i);
+        PROFILE_ADD(collision_start, collision_ticks);
+
+        // Se chegou na base, remove e conta no histograma
+        if (pool->y[i] >= floor_y) {
+            int px = PHYS_TO_INT(pool->x[i]);
+            int bin;
+            if (b->static_geometry && (unsigned)px < OLED_WIDTH) {
+                bin = board_static.bin_of_x[px]; // Tabela da variante compilada
+            } else {
+                bin = (px - b->wall_left - p->wall_offset) / p->bin_width;
+                bin = bin < 0 ? 0 : (bin >= p->num_bins ? p->num_bins-1 : bin);
+            }
 
-            particles[i].bin_position = bin;
-            histogram[bin]++;
+            board_despawn_particle(b, i); // A última partícula passa a ocupar o índice i e é atualizada em seguida
+            if (p->sim_mode != SIM_MODE_PHYSICS) continue; // Amostra animada não entra na contagem
 
-            // Normaliza histograma a cada 10 partículas lançadas
-            if (total_particles % 10 == 0) {
-                normalize_histogram();
-            }
+            histogram_add(&b->hist, bin, 1); // Contagem e estatísticas em O(1); a escala da tela fica para o desenho
+            if (b->telemetry) telemetry_emit(b->telemetry, b->steps, bin, 1, p->balance_bias, p->balls_per_drop);
+            continue;
         }
+
+        i++;
     }
+
+    b->sim_time_ms += p->tick_ms; // Um passo fixo de física
+    b->steps++;
+
+    PROFILE_RECORD(PROF_COLLISIONS, collision_ticks);
+}
+
+/************ Passos ociosos ************/
+uint32_t board_idle_steps(const galton_board_t *b) {
+    const galton_params_t *p = &b->params;
+    if (b->particles.count > 0 || p->sim_mode != SIM_MODE_PHYSICS || p->tick_ms <= 0) return 0;
+
+    // Mesmo teste de board_step: lança no primeiro passo em que o intervalo é ultrapassado
+    uint32_t interval = 1000 / PARTICLES_PER_SECOND;
+    uint32_t since = b->sim_time_ms - b->last_particle_time;
+    if (since > interval) return 0;
+    return (interval - since) / (uint32_t)p->tick_ms + 1;
+}
+
+void board_skip_steps(galton_board_t *b, uint32_t steps) {
+    b->sim_time_ms += steps * (uint32_t)b->params.tick_ms;
+    b->steps += steps;
+}
+
+/************ Atualiza a placa da tela ************/
+void update_particles() {
+    PROFILE_START(update_start);
+    galton_params_t params;
+
+    check_buttons();  // Verifica botões antes de atualizar partículas
+    board_params_from_globals(&params);
+    board_update_params(&main_board, &params);
+    board_step(&main_board);
+    if (replay.mode != REPLAY_OFF) replay_step(&replay, &main_board); // Hash do estado a cada tick
+
+    PROFILE_STOP(update_start, PROF_UPDATE);
+}
+
+// Passos da placa da tela que update_particles() pode pular: sem botão pendente, sem
+// gravação/reprodução (que confere o hash a cada tick) e com a placa ociosa
+uint32_t idle_steps() {
+    if (replay.mode != REPLAY_OFF || input_pending() || SIM_MODE != SIM_MODE_PHYSICS) return 0;
+    return board_idle_steps(&main_board);
+}
+
+// Avança de uma vez os passos ociosos (o mesmo estado que chamar update_particles() 'steps' vezes)
+void skip_idle_steps(uint32_t steps) {
+    board_skip_steps(&main_board, steps);
 }
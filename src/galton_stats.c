@@ -0,0 +1,97 @@
+// Histograma sem perdas e estatísticas incrementais
+
+#include <math.h>
+#include "inc/galton_stats.h"
+
+void histogram_configure(galton_histogram_t *h, int rows, int num_bins) {
+    h->rows = rows;
+    h->num_bins = num_bins;
+    histogram_reset(h);
+}
+
+void histogram_reset(galton_histogram_t *h) {
+    memset(h->bins, 0, sizeof(h->bins));
+    h->max = 0;
+    h->stats.count = 0;
+    h->stats.sum = 0;
+    h->stats.sum_sq = 0;
+    h->stats.sum_cube = 0;
+    h->stats.chi_acc = 0.0;
+}
+
+void histogram_add(galton_histogram_t *h, int bin, uint64_t count) {
+    galton_stats_t *s = &h->stats;
+    if (count == 0) return;
+
+    // Qui-quadrado: com D_k = O_k - n·p_k e Σ D_k = 0, somar m bolas ao bin j muda
+    // Σ D_k²/p_k em (2·m·D_j + m²·(1 - p_j)) / p_j; os outros bins não precisam ser visitados
+    double p = s->expected[bin];
+    if (p > 0.0) {
+        double m = (double)count;
+        double d = (double)h->bins[bin] - (double)s->count * p;
+        s->chi_acc += (2.0 * m * d + m * m * (1.0 - p)) / p;
+    } else {
+        s->chi_acc = INFINITY; // Bin impossível para a binomial ideal
+    }
+
+    uint64_t k = (uint64_t)bin;
+    h->bins[bin] += count;
+    if (h->bins[bin] > h->max) h->max = h->bins[bin];
+    s->count += count;
+    s->sum += k * count;
+    s->sum_sq += k * k * count;
+    s->sum_cube += k * k * k * count;
+}
+
+void histogram_set_reference(galton_histogram_t *h, uint32_t threshold) {
+    galton_stats_t *s = &h->stats;
+    double p = threshold / 4294967296.0; // Probabilidade de ir para a direita em cada pino
+    double q = 1.0 - p;
+
+    // Binomial(rows, p); o que passar do último bin cai nele, como em drop_fast_binomial
+    int rows = h->rows, num_bins = h->num_bins;
+    for (int k = 0; k < num_bins; k++) s->expected[k] = 0.0;
+    double coef = 1.0; // C(rows, k)
+    for (int k = 0; k <= rows; k++) {
+        int bin = k < num_bins ? k : num_bins - 1;
+        s->expected[bin] += coef * pow(p, k) * pow(q, rows - k);
+        coef = coef * (rows - k) / (k + 1);
+    }
+
+    // Referência nova: o acumulador é refeito a partir das contagens (só quando o viés muda)
+    s->chi_acc = 0.0;
+    for (int k = 0; k < num_bins; k++) {
+        if (s->expected[k] > 0.0) {
+            double d = (double)h->bins[k] - (double)s->count * s->expected[k];
+            s->chi_acc += d * d / s->expected[k];
+        } else if (h->bins[k] > 0) {
+            s->chi_acc = INFINITY;
+        }
+    }
+}
+
+/************ Consultas em O(1) ************/
+double stats_mean(const galton_stats_t *s) {
+    return s->count ? (double)s->sum / (double)s->count : 0.0;
+}
+
+double stats_variance(const galton_stats_t *s) {
+    if (s->count == 0) return 0.0;
+    double n = (double)s->count;
+    double mean = (double)s->sum / n;
+    return (double)s->sum_sq / n - mean * mean;
+}
+
+double stats_skewness(const galton_stats_t *s) {
+    double var = stats_variance(s);
+    if (var <= 0.0) return 0.0;
+
+    double n = (double)s->count;
+    double mean = (double)s->sum / n;
+    double m3 = (double)s->sum_cube / n - 3.0 * mean * ((double)s->sum_sq / n) + 2.0 * mean * mean * mean;
+    return m3 / (var * sqrt(var));
+}
+
+double stats_chi_square(const galton_stats_t *s) {
+    return s->count ? s->chi_acc / (double)s->count : 0.0;
+}
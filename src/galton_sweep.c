@@ -0,0 +1,52 @@
+// Varredura de parâmetros em lote
+
+#include "inc/galton_sweep.h"
+
+static galton_board_t sweep_boards[SWEEP_MAX_BOARDS];                        // Arena de placas
+static phys_t sweep_storage[SWEEP_MAX_BOARDS][4 * SWEEP_BOARD_PARTICLES];   // Arena de partículas
+static float sweep_values[SWEEP_MAX_BOARDS];
+static int sweep_count = 0;
+
+int sweep_setup(const galton_params_t *base, sweep_param_t param, float from, float to, float step, uint64_t seed) {
+    sweep_count = 0;
+    if (step <= 0.0f) return 0;
+
+    for (int i = 0; i < SWEEP_MAX_BOARDS; i++) {
+        // Valor calculado pelo índice (e não somando step), sem acumular erro de arredondamento
+        float value = from + step * (float)i;
+        if (value > to + step * 1e-3f) break;
+
+        galton_params_t params = *base;
+        if (param == SWEEP_BIAS) params.balance_bias = value;
+        else params.bounciness = value;
+
+        board_init(&sweep_boards[i], &params, sweep_storage[i], SWEEP_BOARD_PARTICLES, seed, (uint32_t)i + 1);
+        sweep_values[i] = value;
+        sweep_count++;
+    }
+    return sweep_count;
+}
+
+void sweep_run(uint32_t ticks) {
+    // As placas não interagem, então a ordem (placa a placa, em blocos) não muda os resultados
+    for (uint32_t done = 0; done < ticks; done += SWEEP_CHUNK_TICKS) {
+        uint32_t chunk = ticks - done < SWEEP_CHUNK_TICKS ? ticks - done : SWEEP_CHUNK_TICKS;
+
+        for (int i = 0; i < sweep_count; i++) {
+            galton_board_t *b = &sweep_boards[i];
+            for (uint32_t t = 0; t < chunk; t++) board_step(b);
+        }
+    }
+}
+
+int sweep_board_count(void) {
+    return sweep_count;
+}
+
+galton_board_t *sweep_board(int index) {
+    return &sweep_boards[index];
+}
+
+float sweep_value(int index) {
+    return sweep_values[index];
+}
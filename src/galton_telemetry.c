@@ -0,0 +1,277 @@
+// Telemetria binária: anel de eventos, quadros com deltas e decodificação
+
+#include <string.h>
+#include "inc/galton_telemetry.h"
+
+#if GALTON_TELEMETRY && !defined(GALTON_HOST)
+#include "pico/stdlib.h"
+#endif
+
+#define TELEMETRY_MASK (TELEMETRY_RING_SIZE - 1)
+#define TELEMETRY_HEADER_BYTES 4  // Sincronismo e tamanho
+#define TELEMETRY_TRAILER_BYTES 2 // CRC
+
+/* Bits do cabeçalho de cada evento */
+#define EV_BIN_MASK 0x0F
+#define EV_HAS_COUNT 0x10
+#define EV_HAS_BIAS 0x20
+#define EV_HAS_BALLS 0x40
+#define EV_HAS_TICK 0x80
+
+telemetry_ring_t telemetry_ring;
+
+/************ Anel de eventos ************/
+void telemetry_reset(telemetry_ring_t *r) {
+    atomic_store(&r->head, 0);
+    atomic_store(&r->tail, 0);
+    atomic_store(&r->dropped, 0);
+    r->dropped_reported = 0;
+    r->sequence = 0;
+}
+
+void telemetry_emit(telemetry_ring_t *r, uint32_t tick, int bin, uint32_t count, float bias, int balls_per_drop) {
+    unsigned head = atomic_load_explicit(&r->head, memory_order_relaxed);
+    unsigned tail = atomic_load_explicit(&r->tail, memory_order_acquire);
+
+    if (head - tail >= TELEMETRY_RING_SIZE) { // Cheio: a simulação nunca espera pelo envio
+        atomic_fetch_add_explicit(&r->dropped, count, memory_order_relaxed);
+        return;
+    }
+
+    telemetry_event_t *ev = &r->events[head & TELEMETRY_MASK];
+    ev->tick = tick;
+    ev->count = count;
+    ev->bin = (uint8_t)bin;
+    ev->bias_x10 = (uint8_t)(bias * 10.0f + 0.5f);
+    ev->balls_per_drop = (uint8_t)balls_per_drop;
+    atomic_store_explicit(&r->head, head + 1, memory_order_release);
+}
+
+unsigned telemetry_pending(const telemetry_ring_t *r) {
+    return atomic_load_explicit(&r->head, memory_order_acquire) - atomic_load_explicit(&r->tail, memory_order_relaxed);
+}
+
+/************ Codificação ************/
+static uint16_t crc16_ccitt(const uint8_t *data, size_t len) {
+    uint16_t crc = 0xFFFF;
+    for (size_t i = 0; i < len; i++) {
+        crc ^= (uint16_t)data[i] << 8;
+        for (int b = 0; b < 8; b++) crc = (crc & 0x8000) ? (uint16_t)((crc << 1) ^ 0x1021) : (uint16_t)(crc << 1);
+    }
+    return crc;
+}
+
+static uint8_t *put_varint(uint8_t *p, uint32_t v) {
+    while (v >= 0x80) {
+        *p++ = (uint8_t)(v | 0x80);
+        v >>= 7;
+    }
+    *p++ = (uint8_t)v;
+    return p;
+}
+
+// Delta com sinal em varint (zigzag): se a placa for reiniciada o tick volta
+static uint32_t zigzag(int32_t v) {
+    return ((uint32_t)v << 1) ^ (uint32_t)(v >> 31);
+}
+
+size_t telemetry_encode_frame(telemetry_ring_t *r, uint8_t *out) {
+    unsigned tail = atomic_load_explicit(&r->tail, memory_order_relaxed);
+    unsigned n = atomic_load_explicit(&r->head, memory_order_acquire) - tail;
+    uint32_t dropped = atomic_load_explicit(&r->dropped, memory_order_relaxed);
+    uint32_t lost = dropped - r->dropped_reported;
+
+    if (n == 0 && lost == 0) return 0;
+    if (n > TELEMETRY_FRAME_EVENTS) n = TELEMETRY_FRAME_EVENTS;
+
+    // Estado inicial do quadro: o primeiro evento (ou zeros, num quadro só com perdas)
+    telemetry_event_t prev = {0};
+    if (n > 0) prev = r->events[tail & TELEMETRY_MASK];
+
+    uint8_t *payload = out + TELEMETRY_HEADER_BYTES;
+    uint8_t *p = payload;
+    *p++ = TELEMETRY_VERSION;
+    *p++ = (uint8_t)r->sequence;
+    *p++ = (uint8_t)(r->sequence >> 8);
+    p = put_varint(p, lost);
+    p = put_varint(p, prev.tick);
+    *p++ = prev.bias_x10;
+    *p++ = prev.balls_per_drop;
+    p = put_varint(p, n);
+
+    for (unsigned i = 0; i < n; i++) {
+        const telemetry_event_t *ev = &r->events[(tail + i) & TELEMETRY_MASK];
+        uint8_t *head = p++;
+        uint8_t flags = ev->bin & EV_BIN_MASK;
+
+        if (ev->count != 1) {
+            flags |= EV_HAS_COUNT;
+            p = put_varint(p, ev->count);
+        }
+        if (ev->bias_x10 != prev.bias_x10) {
+            flags |= EV_HAS_BIAS;
+            *p++ = ev->bias_x10;
+        }
+        if (ev->balls_per_drop != prev.balls_per_drop) {
+            flags |= EV_HAS_BALLS;
+            *p++ = ev->balls_per_drop;
+        }
+        if (ev->tick != prev.tick) {
+            flags |= EV_HAS_TICK;
+            p = put_varint(p, zigzag((int32_t)(ev->tick - prev.tick)));
+        }
+        *head = flags;
+        prev = *ev;
+    }
+
+    // Libera as posições só depois de copiar os eventos
+    atomic_store_explicit(&r->tail, tail + n, memory_order_release);
+    r->dropped_reported = dropped;
+    r->sequence++;
+
+    size_t len = (size_t)(p - payload);
+    uint16_t crc = crc16_ccitt(payload, len);
+    out[0] = TELEMETRY_SYNC0;
+    out[1] = TELEMETRY_SYNC1;
+    out[2] = (uint8_t)len;
+    out[3] = (uint8_t)(len >> 8);
+    *p++ = (uint8_t)crc;
+    *p++ = (uint8_t)(crc >> 8);
+    return (size_t)(p - out);
+}
+
+void telemetry_flush(telemetry_ring_t *r, telemetry_write_fn write, void *ctx) {
+    uint8_t frame[TELEMETRY_MAX_FRAME];
+    size_t len;
+    while ((len = telemetry_encode_frame(r, frame)) > 0) write(frame, len, ctx);
+}
+
+/************ Decodificação ************/
+void telemetry_parser_init(telemetry_parser_t *p) {
+    memset(p, 0, sizeof(*p));
+}
+
+static bool get_varint(const uint8_t **p, const uint8_t *end, uint32_t *v) {
+    uint32_t result = 0;
+    for (int shift = 0; shift < 35 && *p < end; shift += 7) {
+        uint8_t byte = *(*p)++;
+        result |= (uint32_t)(byte & 0x7F) << shift;
+        if (!(byte & 0x80)) {
+            *v = result;
+            return true;
+        }
+    }
+    return false;
+}
+
+// Decodifica a carga de um quadro com CRC válido; false se o formato não fecha
+static bool parse_payload(telemetry_parser_t *ps, const uint8_t *p, const uint8_t *end,
+                          telemetry_event_fn on_event, void *ctx) {
+    telemetry_event_t ev = {0};
+    uint32_t lost, tick, n;
+
+    if (end - p < 3 || p[0] != TELEMETRY_VERSION) return false;
+    uint16_t sequence = (uint16_t)(p[1] | (p[2] << 8));
+    p += 3;
+    if (!get_varint(&p, end, &lost) || !get_varint(&p, end, &tick) || end - p < 2) return false;
+    ev.tick = tick;
+    ev.bias_x10 = *p++;
+    ev.balls_per_drop = *p++;
+    if (!get_varint(&p, end, &n)) return false;
+
+    if (ps->frames > 0) ps->sequence_gaps += (uint16_t)(sequence - ps->last_sequence - 1);
+    ps->last_sequence = sequence;
+    ps->frames++;
+    ps->events_lost += lost;
+
+    for (uint32_t i = 0; i < n; i++) {
+        if (p >= end) return false;
+        uint8_t flags = *p++;
+        uint32_t delta;
+
+        ev.bin = flags & EV_BIN_MASK;
+        ev.count = 1;
+        if ((flags & EV_HAS_COUNT) && !get_varint(&p, end, &ev.count)) return false;
+        if (flags & EV_HAS_BIAS) {
+            if (p >= end) return false;
+            ev.bias_x10 = *p++;
+        }
+        if (flags & EV_HAS_BALLS) {
+            if (p >= end) return false;
+            ev.balls_per_drop = *p++;
+        }
+        if (flags & EV_HAS_TICK) {
+            if (!get_varint(&p, end, &delta)) return false;
+            ev.tick += (uint32_t)((delta >> 1) ^ -(delta & 1)); // Desfaz o zigzag
+        }
+        on_event(&ev, ctx);
+        ps->events++;
+    }
+    return p == end;
+}
+
+// Descarta 'n' bytes do início do buffer
+static void parser_consume(telemetry_parser_t *p, size_t n) {
+    memmove(p->buf, p->buf + n, p->len - n);
+    p->len -= n;
+}
+
+void telemetry_parse(telemetry_parser_t *p, const uint8_t *data, size_t len, telemetry_event_fn on_event, void *ctx) {
+    while (len > 0) {
+        size_t take = sizeof(p->buf) - p->len;
+        if (take > len) take = len;
+        memcpy(p->buf + p->len, data, take);
+        p->len += take;
+        data += take;
+        len -= take;
+
+        // Extrai todos os quadros completos do buffer
+        while (p->len >= TELEMETRY_HEADER_BYTES) {
+            if (p->buf[0] != TELEMETRY_SYNC0 || p->buf[1] != TELEMETRY_SYNC1) {
+                p->skipped_bytes++;
+                parser_consume(p, 1);
+                continue;
+            }
+
+            size_t payload_len = p->buf[2] | ((size_t)p->buf[3] << 8);
+            size_t frame_len = TELEMETRY_HEADER_BYTES + payload_len + TELEMETRY_TRAILER_BYTES;
+            if (frame_len > sizeof(p->buf)) { // Tamanho impossível: sincronismo falso
+                p->bad_frames++;
+                parser_consume(p, 1);
+                continue;
+            }
+            if (p->len < frame_len) break; // Espera o resto do quadro
+
+            const uint8_t *payload = p->buf + TELEMETRY_HEADER_BYTES;
+            uint16_t crc = (uint16_t)(payload[payload_len] | (payload[payload_len + 1] << 8));
+            if (crc != crc16_ccitt(payload, payload_len) ||
+                !parse_payload(p, payload, payload + payload_len, on_event, ctx)) {
+                p->bad_frames++;
+                parser_consume(p, 1); // Procura o próximo sincronismo dentro deste quadro
+                continue;
+            }
+            parser_consume(p, frame_len);
+        }
+    }
+}
+
+/************ Envio pela USB (firmware) ************/
+#if GALTON_TELEMETRY && !defined(GALTON_HOST)
+static absolute_time_t telemetry_last_flush;
+
+static void usb_write(const uint8_t *data, size_t len, void *ctx) {
+    (void)ctx;
+    for (size_t i = 0; i < len; i++) putchar_raw(data[i]); // Sem conversão de \n em \r\n
+}
+
+void telemetry_poll(void) {
+    absolute_time_t now = get_absolute_time();
+
+    if (telemetry_pending(&telemetry_ring) >= TELEMETRY_FRAME_EVENTS ||
+        absolute_time_diff_us(telemetry_last_flush, now) >= TELEMETRY_FLUSH_MS * 1000ll) {
+        telemetry_flush(&telemetry_ring, usb_write, NULL);
+        stdio_flush();
+        telemetry_last_flush = now;
+    }
+}
+#endif
@@ -0,0 +1,56 @@
+// Campos de texto com formatação inteira e glifos em cache
+
+#include <string.h>
+#include "inc/galton_text.h"
+#include "inc/ssd1306.h"
+
+/************ Formatação inteira ************/
+int text_format_u64(char *out, uint64_t value) {
+    char digits[TEXT_MAX_DIGITS];
+    int n = 0;
+
+    // Até 2^32 a divisão é de 32 bits (divisor em hardware no RP2040); acima, a de 64 bits da biblioteca
+    while (value > UINT32_MAX) {
+        digits[n++] = (char)('0' + value % 10);
+        value /= 10;
+    }
+    uint32_t small = (uint32_t)value;
+    do {
+        digits[n++] = (char)('0' + small % 10);
+        small /= 10;
+    } while (small);
+
+    for (int i = 0; i < n; i++) out[i] = digits[n - 1 - i];
+    out[n] = '\0';
+    return n;
+}
+
+int text_format_i64(char *out, int64_t value) {
+    if (value >= 0) return text_format_u64(out, (uint64_t)value);
+    out[0] = '-';
+    return 1 + text_format_u64(out + 1, 0 - (uint64_t)value);
+}
+
+/************ Campos em cache ************/
+void text_field_set(text_field_t *f, int64_t value) {
+    char text[TEXT_FIELD_MAX_CHARS + TEXT_MAX_DIGITS + 2];
+    if (f->valid && f->value == value) return; // Nada mudou: o cache continua valendo
+
+    size_t len = strlen(f->prefix);
+    if (len > TEXT_FIELD_MAX_CHARS) len = TEXT_FIELD_MAX_CHARS;
+    memcpy(text, f->prefix, len);
+    len += (size_t)text_format_i64(text + len, value);
+    if (len > TEXT_FIELD_MAX_CHARS) len = TEXT_FIELD_MAX_CHARS; // O que passa da tela é cortado
+
+    for (size_t i = 0; i < len; i++) memcpy(&f->columns[i * 8], ssd1306_glyph((uint8_t)text[i]), 8);
+    f->width = (uint8_t)(len * 8);
+    f->value = value;
+    f->valid = true;
+    f->renders++;
+}
+
+void text_field_draw(const text_field_t *f, uint8_t *buffer) {
+    if (!f->valid) return;
+    int x = f->right_aligned ? f->x - f->width : f->x;
+    ssd1306_blit_columns(buffer, x, f->y, f->columns, f->width);
+}